@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+#include <esp_timer.h>
+#include <driver/uart.h>
+#include <driver/rmt.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "TimeHal.h"
+
+//================================================================================
+// ZAMANLAMA CEKIRDEGI - WT32-ETH01 UYGULAMALARI
+//================================================================================
+
+class WiFiUdpTransport : public UdpTransport {
+public:
+    explicit WiFiUdpTransport(WiFiUDP &udp) : udp_(udp) {}
+
+    bool send(uint32_t ip, uint16_t port, const uint8_t *data, size_t len) override;
+    size_t receive(uint8_t *buf, size_t capacity, uint32_t *fromIp, uint16_t *fromPort) override;
+
+private:
+    WiFiUDP &udp_;
+};
+
+// lwIP soketi uzerinde dogrudan UDP. receive() datagrami MSG_DONTWAIT ile
+// cagiranin tamponuna alir: WiFiUDP::parsePacket()'in her cagrida ayirdigi
+// alim tamponu ve paket kopyasi yoktur. Tampondan uzun datagram kesilir.
+class LwipUdpTransport : public UdpTransport {
+public:
+    LwipUdpTransport() : fd_(-1) {}
+
+    // Tum arayuzlerde port'a baglanir
+    bool begin(uint16_t port);
+    void stop();
+    bool isOpen() const { return fd_ >= 0; }
+
+    bool send(uint32_t ip, uint16_t port, const uint8_t *data, size_t len) override;
+    size_t receive(uint8_t *buf, size_t capacity, uint32_t *fromIp, uint16_t *fromPort) override;
+
+private:
+    int fd_;
+};
+
+class EspMonotonicClock : public MonotonicClock {
+public:
+    int64_t nowUs() override { return esp_timer_get_time(); }
+};
+
+#define IDF_UART_EVENT_QUEUE_LEN 16
+
+// UART hata/olay sayaclari. Yalnizca RX gorevi yazar; diger gorevler okur.
+struct UartRxCounters {
+    volatile uint32_t bytes;
+    volatile uint32_t wakeups;          // Veri olayi (FIFO esigi ya da hat bosta zaman asimi)
+    volatile uint32_t fifoOverflows;    // Donanim FIFO tasti, bayt kaybi
+    volatile uint32_t bufferFull;       // Surucu halka tamponu doldu, bayt kaybi
+    volatile uint32_t framingErrors;
+    volatile uint32_t parityErrors;
+    volatile uint32_t breaks;
+};
+
+// ESP-IDF UART surucusu uzerinde port. Alim, surucunun olay kuyrugundan
+// yurur: bekleyen gorev yalnizca veri ya da hata oldugunda uyanir.
+class IdfUartPort : public SerialPort {
+public:
+    explicit IdfUartPort(uart_port_t port) : port_(port), queue_(NULL), counters_() {}
+
+    // eventSet verilirse olay kuyrugu pinler baglanmadan (kuyruk bosken) kumeye eklenir.
+    // txBufferSize 0: write() baytlari dogrudan donanim FIFO'suna koyar.
+    bool begin(uint32_t baud, int rxPin, int txPin, size_t rxBufferSize, size_t txBufferSize,
+               QueueSetHandle_t eventSet = NULL);
+
+    size_t write(const uint8_t *data, size_t len) override;
+    size_t print(const char *text);
+    void flush();
+    // Son durma biti hattan cikana kadar (TX_DONE kesmesi) gorevi uyutur
+    bool waitTxDone(uint32_t timeoutMs);
+
+    QueueHandle_t eventQueue() const { return queue_; }
+
+    // Kuyruktaki bir olayi alir ve sayaclari gunceller. Tasma olaylarinda giris
+    // temizlenir. Okunacak veri olabilecekse true.
+    bool serviceEvent();
+
+    // Surucu tamponundaki baytlari beklemeden okur
+    size_t read(uint8_t *buf, size_t capacity);
+
+    const UartRxCounters &counters() const { return counters_; }
+
+private:
+    uart_port_t port_;
+    QueueHandle_t queue_;
+    UartRxCounters counters_;
+};
+
+// RMT ile PPS: 1 us tik; pulse() tek ogeyi yazar ve kenari hemen baslatir.
+// Ogenin sure alani 15 bittir, genislik RMT_PULSE_MAX_US ile sinirlanir.
+#define RMT_PULSE_MAX_US 32767
+
+class RmtPulseOutput : public PulseOutput {
+public:
+    explicit RmtPulseOutput(rmt_channel_t channel) : channel_(channel), ready_(false) {}
+
+    bool begin(gpio_num_t pin);
+    bool pulse(uint32_t widthUs) override;
+
+private:
+    rmt_channel_t channel_;
+    bool ready_;
+};
+
+IPAddress toIPAddress(uint32_t ip);
+uint32_t fromIPAddress(const IPAddress &addr);
@@ -0,0 +1,78 @@
+#include "CivilTime.h"
+
+// Gun sayaci Unix epoch'tan baslar; 400'e bolunen yuzyil artiktir (2000),
+// bolunmeyen degildir (2100)
+static_assert(daysFromCivil(1970, 1, 1) == 0, "daysFromCivil: 1970-01-01 gun 0 olmali");
+static_assert(daysFromCivil(2000, 3, 1) == 11017, "daysFromCivil: 2000-03-01 (artik yuzyil sonrasi)");
+static_assert(daysFromCivil(2000, 3, 1) - daysFromCivil(2000, 2, 28) == 2, "daysFromCivil: 2000 artik yil");
+static_assert(daysFromCivil(2100, 3, 1) == 47541, "daysFromCivil: 2100-03-01 (artik olmayan yuzyil)");
+static_assert(daysFromCivil(2100, 3, 1) - daysFromCivil(2100, 2, 28) == 1, "daysFromCivil: 2100 artik yil degil");
+
+CivilDate civilFromDays(int32_t days) {
+    days += 719468;
+    int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+    uint32_t doe = (uint32_t)(days - era * 146097);
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+
+    CivilDate date;
+    date.day = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+    date.month = (uint8_t)(mp < 10 ? mp + 3 : mp - 9);
+    date.year = (int32_t)yoe + era * 400 + (date.month <= 2 ? 1 : 0);
+    return date;
+}
+
+CivilClock::CivilClock(int32_t utcOffsetS)
+    : utcOffsetS_(utcOffsetS), utcSecond_(0), valid_(false), days_(0),
+      hour_(0), minute_(0), second_(0), fullRecomputes_(0) {
+    date_.year = 1970;
+    date_.month = 1;
+    date_.day = 1;
+}
+
+void CivilClock::seek(uint32_t utcSecond) {
+    if (valid_ && utcSecond == utcSecond_) {
+        return;
+    }
+    if (!valid_ || utcSecond != utcSecond_ + 1) {
+        recompute(utcSecond);
+        return;
+    }
+
+    utcSecond_ = utcSecond;
+    if (++second_ < 60) {
+        return;
+    }
+    second_ = 0;
+    if (++minute_ < 60) {
+        return;
+    }
+    minute_ = 0;
+    if (++hour_ < 24) {
+        return;
+    }
+    hour_ = 0;
+    days_++;
+    date_ = civilFromDays(days_);
+    fullRecomputes_++;
+}
+
+void CivilClock::recompute(uint32_t utcSecond) {
+    int64_t local = (int64_t)utcSecond + utcOffsetS_;
+    int64_t days = local / 86400;
+    int64_t secondOfDay = local - days * 86400;
+    if (secondOfDay < 0) {
+        secondOfDay += 86400;
+        days--;
+    }
+
+    days_ = (int32_t)days;
+    date_ = civilFromDays(days_);
+    hour_ = (uint8_t)(secondOfDay / 3600);
+    minute_ = (uint8_t)((secondOfDay / 60) % 60);
+    second_ = (uint8_t)(secondOfDay % 60);
+    utcSecond_ = utcSecond;
+    valid_ = true;
+    fullRecomputes_++;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdint.h>
+
+//================================================================================
+// SIVIL TAKVIM (SABIT UTC OFSETI)
+//================================================================================
+// Epoch gunu <-> yil/ay/gun donusumu (proleptik Gregoryen, H. Hinnant
+// algoritmasi). localtime() gibi kilit, TZ ortam degiskeni ya da ortak
+// statik bellek kullanmaz. CivilClock ardisik saniyelerde yalnizca saat
+// alanlarini artirir; tam hesap gun degisiminde ya da atlamada yapilir.
+
+// Mart tabanli yil: Subat sonu artik gunu yilin sonuna dusurur
+constexpr int32_t civilEra(int32_t y) {
+    return (y >= 0 ? y : y - 399) / 400;
+}
+
+constexpr int32_t civilDayOfYear(uint32_t m, uint32_t d) {
+    return (int32_t)((153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1);
+}
+
+constexpr int32_t civilDayOfEra(int32_t yoe, uint32_t m, uint32_t d) {
+    return yoe * 365 + yoe / 4 - yoe / 100 + civilDayOfYear(m, d);
+}
+
+constexpr int32_t civilDaysShifted(int32_t y, uint32_t m, uint32_t d) {
+    return civilEra(y) * 146097 + civilDayOfEra(y - civilEra(y) * 400, m, d) - 719468;
+}
+
+// 1970-01-01'den beri gun sayisi
+constexpr int32_t daysFromCivil(int32_t y, uint32_t m, uint32_t d) {
+    return civilDaysShifted(m <= 2 ? y - 1 : y, m, d);
+}
+
+struct CivilDate {
+    int32_t year;
+    uint8_t month;      // 1..12
+    uint8_t day;        // 1..31
+};
+
+CivilDate civilFromDays(int32_t days);
+
+class CivilClock {
+public:
+    explicit CivilClock(int32_t utcOffsetS);
+
+    // Verilen UTC saniyesinin yerel alanlarina konumlanir
+    void seek(uint32_t utcSecond);
+
+    uint8_t hour() const { return hour_; }
+    uint8_t minute() const { return minute_; }
+    uint8_t second() const { return second_; }
+    uint8_t day() const { return date_.day; }
+    uint8_t month() const { return date_.month; }
+    uint8_t yearOfCentury() const { return (uint8_t)(date_.year % 100); }
+    int32_t year() const { return date_.year; }
+
+    uint32_t fullRecomputes() const { return fullRecomputes_; }
+
+private:
+    void recompute(uint32_t utcSecond);
+
+    int32_t utcOffsetS_;
+    uint32_t utcSecond_;
+    bool valid_;
+    int32_t days_;              // Yerel epoch gunu
+    CivilDate date_;
+    uint8_t hour_;
+    uint8_t minute_;
+    uint8_t second_;
+    uint32_t fullRecomputes_;
+};
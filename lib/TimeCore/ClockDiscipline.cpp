@@ -0,0 +1,136 @@
+#include "ClockDiscipline.h"
+
+static int64_t absI64(int64_t v) { return v < 0 ? -v : v; }
+
+ClockDiscipline::ClockDiscipline() : timeConstantS_(DISC_DEFAULT_TIME_CONSTANT_S) {
+    reset();
+}
+
+void ClockDiscipline::reset() {
+    state_ = DISC_UNSET;
+    warm_ = false;
+    anchorLocalUs_ = 0;
+    anchorUtcUs_ = 0;
+    freqPpb_ = 0;
+    slewUs_ = 0;
+    slewDurationUs_ = 1;
+    lastUpdateLocalUs_ = 0;
+    lastOffsetUs_ = 0;
+    jitterUs_ = 0;
+    stepCount_ = 0;
+}
+
+void ClockDiscipline::warmStart(int32_t freqPpb) {
+    reset();
+    addFrequency(freqPpb);
+    warm_ = true;
+}
+
+void ClockDiscipline::setTimeConstant(uint32_t seconds) {
+    timeConstantS_ = seconds < 1 ? 1 : seconds;
+}
+
+int64_t ClockDiscipline::toUtcUs(int64_t localUs) const {
+    int64_t dt = localUs - anchorLocalUs_;
+    int64_t utc = anchorUtcUs_ + dt + (dt * freqPpb_) / 1000000000LL;
+
+    if (slewUs_ != 0) {
+        if (dt >= slewDurationUs_) {
+            utc += slewUs_;
+        } else if (dt > 0) {
+            utc += (slewUs_ * dt) / slewDurationUs_;
+        }
+    }
+    return utc;
+}
+
+int64_t ClockDiscipline::toLocalUs(int64_t utcUs) const {
+    // Egim ~1 oldugundan birkac duzeltme adimi us alti hassasiyete yeter
+    int64_t local = anchorLocalUs_ + (utcUs - anchorUtcUs_);
+    for (int i = 0; i < 3; i++) {
+        local += utcUs - toUtcUs(local);
+    }
+    return local;
+}
+
+void ClockDiscipline::anchor(int64_t localUs, int64_t utcUs) {
+    anchorLocalUs_ = localUs;
+    anchorUtcUs_ = utcUs;
+    slewUs_ = 0;
+}
+
+void ClockDiscipline::addFrequency(int64_t deltaPpb) {
+    int64_t f = (int64_t)freqPpb_ + deltaPpb;
+    if (f > DISC_MAX_FREQ_PPB) f = DISC_MAX_FREQ_PPB;
+    if (f < -DISC_MAX_FREQ_PPB) f = -DISC_MAX_FREQ_PPB;
+    freqPpb_ = (int32_t)f;
+}
+
+DisciplineAction ClockDiscipline::update(int64_t localUs, int64_t measuredUtcUs) {
+    if (state_ == DISC_UNSET) {
+        anchor(localUs, measuredUtcUs);
+        lastUpdateLocalUs_ = localUs;
+        lastOffsetUs_ = 0;
+        state_ = warm_ ? DISC_SYNC : DISC_FREQ;
+        return DISC_STEPPED;
+    }
+
+    int64_t dtUs = localUs - lastUpdateLocalUs_;
+    if (dtUs <= 0) {
+        return DISC_IGNORED;
+    }
+
+    int64_t offset = measuredUtcUs - toUtcUs(localUs);
+    lastOffsetUs_ = offset;
+
+    // Jitter: ofsetlerin karesel ortalamasi (1/4 agirlikli EWMA)
+    int64_t diff = absI64(offset);
+    if (diff > 0xFFFFFFFLL) diff = 0xFFFFFFFLL;
+    uint64_t j2 = (uint64_t)jitterUs_ * jitterUs_;
+    j2 = (j2 * 3 + (uint64_t)(diff * diff)) / 4;
+    uint32_t root = 0;
+    for (uint32_t bit = 1UL << 20; bit != 0; bit >>= 1) {
+        uint32_t trial = root | bit;
+        if ((uint64_t)trial * trial <= j2) root = trial;
+    }
+    jitterUs_ = root;
+
+    if (absI64(offset) > DISC_STEP_THRESHOLD_US) {
+        anchor(localUs, measuredUtcUs);
+        lastUpdateLocalUs_ = localUs;
+        stepCount_++;
+        return DISC_STEPPED;
+    }
+
+    if (state_ == DISC_FREQ) {
+        // Iki olcum arasindaki egimden frekansi dogrudan kestir
+        if (dtUs < (int64_t)DISC_MIN_FREQ_INTERVAL_S * 1000000) {
+            return DISC_IGNORED;
+        }
+        addFrequency((offset * 1000000000LL) / dtUs);
+        anchor(localUs, measuredUtcUs);
+        lastUpdateLocalUs_ = localUs;
+        state_ = DISC_SYNC;
+        return DISC_FREQ_SET;
+    }
+
+    // Sureklilik icin mevcut disiplinli zamandan yeniden baglan
+    int64_t nowUtc = toUtcUs(localUs);
+    int64_t dtS = dtUs / 1000000;
+    int64_t tau = (int64_t)timeConstantS_;
+
+    // PLL: df = offset * dt / (4*tau)^2
+    int64_t pll = (offset * 1000 * dtS) / (16 * tau * tau);
+    // FLL: uzun araliklarda dogrudan egim, 1/4 kazanc
+    int64_t fll = 0;
+    if (dtS >= DISC_ALLAN_INTERCEPT_S) {
+        fll = (offset * 1000000000LL) / dtUs / 4;
+    }
+    addFrequency(pll + fll);
+
+    anchor(localUs, nowUtc);
+    slewUs_ = offset;
+    slewDurationUs_ = tau * 1000000;
+    lastUpdateLocalUs_ = localUs;
+    return DISC_SLEWED;
+}
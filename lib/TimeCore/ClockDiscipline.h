@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stdint.h>
+
+//================================================================================
+// SAAT DISIPLINI (PLL/FLL)
+//================================================================================
+// Yerel monoton saati (esp_timer) UTC'ye baglayan yazilim saat dongusu.
+// Her NTP olcumunde faz hatasi zaman sabiti boyunca dogrusal olarak
+// yumusatilir (slew), frekans hatasi ppb cinsinden tahmin edilip surekli
+// uygulanir. Boylece iki sorgu arasinda kristal hatasi birikmez.
+//
+// Tamamen tam sayi aritmetigi ile calisir ve deterministiktir; ayni olcum
+// dizisi her platformda ayni sonucu verir.
+
+enum DisciplineState {
+    DISC_UNSET,     // Hic olcum yok, saat gecersiz
+    DISC_FREQ,      // Ilk olcum alindi, frekans icin ikinci olcum bekleniyor
+    DISC_SYNC       // Normal PLL/FLL calismasi
+};
+
+enum DisciplineAction {
+    DISC_IGNORED,   // Olcum kullanilmadi (zaman geri gitti vb.)
+    DISC_STEPPED,   // Faz dogrudan ayarlandi
+    DISC_FREQ_SET,  // Frekans iki olcumden dogrudan hesaplandi
+    DISC_SLEWED     // Normal dongu guncellemesi
+};
+
+#define DISC_DEFAULT_TIME_CONSTANT_S    16
+#define DISC_STEP_THRESHOLD_US          128000      // RFC 5905 STEPT
+#define DISC_MAX_FREQ_PPB               500000      // +-500 ppm
+#define DISC_ALLAN_INTERCEPT_S          1500        // Bu araligin ustunde FLL devrede
+#define DISC_MIN_FREQ_INTERVAL_S        4           // FREQ durumunda minimum olcum araligi
+
+class ClockDiscipline {
+public:
+    ClockDiscipline();
+
+    void reset();
+    // Onceki calismadan bilinen frekansla baslar: ilk olcum yalnizca fazi
+    // ayarlar, frekans olcumu (DISC_FREQ) atlanip dogrudan SYNC'e gecilir
+    void warmStart(int32_t freqPpb);
+    bool warmStarted() const { return warm_; }
+    void setTimeConstant(uint32_t seconds);
+    uint32_t timeConstant() const { return timeConstantS_; }
+
+    // localUs anindaki gercek UTC olcumunu (measuredUtcUs) donguye verir.
+    DisciplineAction update(int64_t localUs, int64_t measuredUtcUs);
+
+    // Disiplinli saat: yerel an -> UTC (us). isValid() false iken anlamsizdir.
+    int64_t toUtcUs(int64_t localUs) const;
+
+    // Ters donusum: UTC anina karsilik gelen yerel an. Zamanlayici kurarken
+    // hedef UTC aninin esp_timer karsiligini bulmak icin kullanilir.
+    int64_t toLocalUs(int64_t utcUs) const;
+
+    bool isValid() const { return state_ != DISC_UNSET; }
+    DisciplineState state() const { return state_; }
+    int32_t frequencyPpb() const { return freqPpb_; }
+    int64_t lastOffsetUs() const { return lastOffsetUs_; }  // Son olcumdeki faz hatasi
+    uint32_t jitterUs() const { return jitterUs_; }
+    uint32_t stepCount() const { return stepCount_; }
+
+private:
+    void anchor(int64_t localUs, int64_t utcUs);
+    void addFrequency(int64_t deltaPpb);
+
+    DisciplineState state_;
+    uint32_t timeConstantS_;
+    bool warm_;
+
+    // Dogrusal model: utc = anchorUtc + dt + dt*freq + slew(dt)
+    int64_t anchorLocalUs_;
+    int64_t anchorUtcUs_;
+    int32_t freqPpb_;
+    int64_t slewUs_;            // Anchor'dan itibaren yumusatilacak faz
+    int64_t slewDurationUs_;
+
+    int64_t lastUpdateLocalUs_;
+    int64_t lastOffsetUs_;
+    uint32_t jitterUs_;
+    uint32_t stepCount_;
+};
@@ -0,0 +1,71 @@
+#include "Console.h"
+
+#include <string.h>
+
+void ConsoleLineReader::reset() {
+    buf_[0] = '\0';
+    length_ = 0;
+    overflow_ = false;
+    complete_ = false;
+}
+
+bool ConsoleLineReader::feed(char c) {
+    if (complete_) {
+        reset();
+    }
+
+    if (c == '\r' || c == '\n') {
+        // \r\n ikinci bir bos satir uretmez
+        if (length_ == 0 && !overflow_) {
+            return false;
+        }
+        while (length_ > 0 && buf_[length_ - 1] == ' ') {
+            length_--;
+        }
+        buf_[length_] = '\0';
+        complete_ = true;
+        return true;
+    }
+
+    if (c == '\b' || c == 0x7F) {
+        if (length_ > 0 && !overflow_) {
+            buf_[--length_] = '\0';
+        }
+        return false;
+    }
+
+    if (c == '\t') {
+        c = ' ';
+    }
+    if ((uint8_t)c < 0x20 || (c == ' ' && length_ == 0)) {
+        return false;
+    }
+
+    if (length_ >= CONSOLE_LINE_MAX) {
+        overflow_ = true;
+        return false;
+    }
+    buf_[length_++] = c;
+    buf_[length_] = '\0';
+    return false;
+}
+
+const ConsoleCommand *consoleFind(const ConsoleCommand *table, size_t count,
+                                  const char *line, const char **args) {
+    size_t wordLen = 0;
+    while (line[wordLen] != '\0' && line[wordLen] != ' ') {
+        wordLen++;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (strlen(table[i].name) == wordLen && strncmp(table[i].name, line, wordLen) == 0) {
+            const char *rest = line + wordLen;
+            while (*rest == ' ') {
+                rest++;
+            }
+            *args = rest;
+            return &table[i];
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+//================================================================================
+// SERI KONSOL: SATIR OKUYUCU VE KOMUT TABLOSU
+//================================================================================
+// Satir okuyucu karakter karakter beslenir ve hicbir zaman beklemez; cagiran
+// yalnizca o an tamponda olan baytlari verir. Satir sonu (\r, \n ya da \r\n)
+// gelince satir bas/son bosluklari atilmis olarak hazir olur. Bos satirlar
+// yok sayilir, backspace son karakteri siler, kontrol karakterleri atlanir.
+// CONSOLE_LINE_MAX'tan uzun satir kesilmez, satir sonunda reddedilir.
+//
+// Komutlar sabit bir tabloda tutulur; satirin ilk kelimesi komut adiyla
+// eslesir, kalani (bosluklar atlanmis) isleyiciye arguman olarak gider.
+
+#define CONSOLE_LINE_MAX        50
+
+class ConsoleLineReader {
+public:
+    ConsoleLineReader() { reset(); }
+
+    void reset();
+
+    // Satir tamamlandiginda true; line()/overflowed() bir sonraki feed'e
+    // kadar gecerlidir
+    bool feed(char c);
+
+    const char *line() const { return buf_; }
+    bool overflowed() const { return overflow_; }
+
+private:
+    char buf_[CONSOLE_LINE_MAX + 1];
+    uint8_t length_;
+    bool overflow_;
+    bool complete_;
+};
+
+// false: argumanlar gecersiz, cagiran kullanim bilgisini yazar
+typedef bool (*ConsoleHandler)(const char *args);
+
+struct ConsoleCommand {
+    const char *name;
+    const char *usage;          // Arguman bicimi, yoksa ""
+    const char *help;
+    ConsoleHandler handler;
+};
+
+// Satirin ilk kelimesini tabloda arar; bulunursa *args komut adindan
+// sonraki ilk bos olmayan karaktere (ya da bos dizgeye) isaret eder
+const ConsoleCommand *consoleFind(const ConsoleCommand *table, size_t count,
+                                  const char *line, const char **args);
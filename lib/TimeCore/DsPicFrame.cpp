@@ -0,0 +1,141 @@
+#include "DsPicFrame.h"
+
+#include <stdio.h>
+
+uint8_t calculateChecksum(const char *str, uint8_t len) {
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < len; i++) {
+        sum += (str[i] - '0');
+    }
+    return sum % 10;
+}
+
+static void buildFrame(char *out, unsigned a, unsigned b, unsigned c, char checksumBase) {
+    snprintf(out, PIC_FRAME_LEN, "%02u%02u%02u", a % 100, b % 100, c % 100);
+    out[6] = checksumBase + calculateChecksum(out, 6);
+    out[7] = '\0';
+}
+
+void buildPicDateFrame(char *out, uint8_t day, uint8_t month, uint8_t year) {
+    buildFrame(out, day, month, year, 'A');
+}
+
+void buildPicTimeFrame(char *out, uint8_t hour, uint8_t minute, uint8_t second) {
+    buildFrame(out, hour, minute, second, 'a');
+}
+
+static const uint16_t CRC16_TABLE[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+uint16_t crc16Ccitt(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc = (uint16_t)((crc << 8) ^ CRC16_TABLE[(uint8_t)((crc >> 8) ^ data[i])]);
+    }
+    return crc;
+}
+
+void buildPicV2Frame(uint8_t *out, const PicV2Fields &fields) {
+    uint8_t errorMs = fields.errorMs > PIC_V2_ERROR_MS_MAX ? PIC_V2_ERROR_MS_MAX : fields.errorMs;
+    out[0] = PIC_V2_STX;
+    out[1] = PIC_V2_VERSION;
+    out[2] = fields.sequence;
+    out[3] = fields.year;
+    out[4] = fields.month;
+    out[5] = fields.day;
+    out[6] = fields.hour;
+    out[7] = fields.minute;
+    out[8] = fields.second;
+    out[9] = (uint8_t)(fields.msPhase >> 8);
+    out[10] = (uint8_t)fields.msPhase;
+    out[11] = (uint8_t)((fields.quality & PIC_V2_QUALITY_MASK) | (errorMs << 2));
+    uint16_t crc = crc16Ccitt(out + 1, 11);
+    out[12] = (uint8_t)(crc >> 8);
+    out[13] = (uint8_t)crc;
+    out[14] = PIC_V2_ETX;
+}
+
+bool parsePicV2Frame(const uint8_t *frame, PicV2Fields &fields) {
+    if (frame[0] != PIC_V2_STX || frame[14] != PIC_V2_ETX || frame[1] != PIC_V2_VERSION) {
+        return false;
+    }
+    if (crc16Ccitt(frame + 1, 11) != (uint16_t)((frame[12] << 8) | frame[13])) {
+        return false;
+    }
+    fields.sequence = frame[2];
+    fields.year = frame[3];
+    fields.month = frame[4];
+    fields.day = frame[5];
+    fields.hour = frame[6];
+    fields.minute = frame[7];
+    fields.second = frame[8];
+    fields.msPhase = (uint16_t)((frame[9] << 8) | frame[10]);
+    fields.quality = frame[11] & PIC_V2_QUALITY_MASK;
+    fields.errorMs = frame[11] >> 2;
+    return true;
+}
+
+PicFrameCache::PicFrameCache() : front_(0) {
+    invalidate();
+}
+
+void PicFrameCache::publish(uint32_t second, PicFrameKind kind, uint8_t length, uint32_t prepareUs) {
+    Slot &back = slot_[front_ ^ 1];
+    back.second = second;
+    back.kind = kind;
+    back.length = length;
+    back.prepareUs = prepareUs;
+    back.ready = true;
+    front_ ^= 1;
+}
+
+const char *PicFrameCache::frameFor(uint32_t second, PicFrameKind kind) const {
+    const Slot &front = slot_[front_];
+    if (!front.ready || front.second != second || front.kind != kind) {
+        return 0;
+    }
+    return front.frame;
+}
+
+void PicFrameCache::invalidate() {
+    for (uint8_t i = 0; i < 2; i++) {
+        slot_[i].frame[0] = '\0';
+        slot_[i].second = 0;
+        slot_[i].prepareUs = 0;
+        slot_[i].kind = PIC_FRAME_DATE;
+        slot_[i].length = 0;
+        slot_[i].ready = false;
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+//================================================================================
+// dsPIC KARE FORMATI
+//================================================================================
+// 6 ASCII rakam + kontrol karakteri:
+//   Tarih: GGAAYY + 'A'+checksum
+//   Saat : SSDDss + 'a'+checksum
+// checksum = rakamlar toplami mod 10
+
+#define PIC_FRAME_LEN 7
+
+uint8_t calculateChecksum(const char *str, uint8_t len);
+
+// out en az PIC_FRAME_LEN + 1 bayt olmalidir (sonuna '\0' yazilir)
+void buildPicDateFrame(char *out, uint8_t day, uint8_t month, uint8_t year);
+void buildPicTimeFrame(char *out, uint8_t hour, uint8_t minute, uint8_t second);
+
+//================================================================================
+// dsPIC KARE FORMATI v2 (IKILI)
+//================================================================================
+// Her saniye tam zaman tek karede; istege bagli, varsayilan v1'dir:
+//   [0]  STX (0x02)          [1]  surum (2)          [2]  sira no
+//   [3]  yil (00..99)        [4]  ay                 [5]  gun
+//   [6]  saat                [7]  dakika             [8]  saniye
+//   [9..10]  ms fazi (big-endian): ilk baytin UART'a yazildigi anin saniye
+//            icindeki ms'si (hedef an eksi TX erken alma suresi)
+//   [11] kalite: bit0-1 ClockQuality, bit2-7 hata siniri (ms, 63'te doyar)
+//   [12..13] CRC-16/CCITT-FALSE (big-endian), [1..11] uzerinden
+//   [14] ETX (0x03)
+// Sira no her gonderilen v2 karede bir artar; atlanan saniyeler ve kayip
+// kareler dsPIC tarafinda ayrilabilir. 'X'/'Y'/'H' durum baytlari STX ile
+// karismaz.
+
+#define PIC_V2_FRAME_LEN        15
+#define PIC_V2_STX              0x02
+#define PIC_V2_ETX              0x03
+#define PIC_V2_VERSION          2
+#define PIC_V2_QUALITY_MASK     0x03
+#define PIC_V2_ERROR_MS_MAX     63
+
+#define PIC_FRAME_MAX_LEN       PIC_V2_FRAME_LEN
+
+struct PicV2Fields {
+    uint8_t sequence;
+    uint8_t year;               // Yuzyil icindeki yil
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+    uint16_t msPhase;
+    uint8_t quality;            // ClockQuality
+    uint8_t errorMs;
+};
+
+// Tablo tabanli CRC-16/CCITT-FALSE (poly 0x1021, baslangic 0xFFFF)
+uint16_t crc16Ccitt(const uint8_t *data, size_t len);
+
+// out en az PIC_V2_FRAME_LEN bayt olmalidir
+void buildPicV2Frame(uint8_t *out, const PicV2Fields &fields);
+// Cerceve, surum ve CRC dogruysa true (dsPIC tarafinin referansi)
+bool parsePicV2Frame(const uint8_t *frame, PicV2Fields &fields);
+
+//================================================================================
+// SIRADAKI KARE ONBELLEGI
+//================================================================================
+// Bekleyen saniyenin karesi (checksum dahil) gonderim anindan once, zamanlayici
+// kurulurken hazirlanir. Gonderim aninda yalnizca hazir kare UART'a yazilir.
+// Iki yuva: biri yazilirken digeri (son yayinlanan) okunur. Kare turu de
+// anahtardir; bicim degisince eski tur kare eslesmez.
+
+enum PicFrameKind {
+    PIC_FRAME_DATE,
+    PIC_FRAME_TIME,
+    PIC_FRAME_V2
+};
+
+inline uint8_t picFrameLength(PicFrameKind kind) {
+    return kind == PIC_FRAME_V2 ? PIC_V2_FRAME_LEN : PIC_FRAME_LEN;
+}
+
+class PicFrameCache {
+public:
+    PicFrameCache();
+
+    // Arka yuva; doldurulduktan sonra publish() ile one alinir
+    char *beginPrepare() { return slot_[front_ ^ 1].frame; }
+    void publish(uint32_t second, PicFrameKind kind, uint8_t length, uint32_t prepareUs);
+
+    // Istenen saniye ve tur icin hazir kare; yoksa NULL
+    const char *frameFor(uint32_t second, PicFrameKind kind) const;
+    uint8_t length() const { return slot_[front_].length; }
+    // Son yayinlanan karenin hazirlanma suresi (us)
+    uint32_t prepareUs() const { return slot_[front_].prepareUs; }
+    void invalidate();
+
+private:
+    struct Slot {
+        char frame[PIC_FRAME_MAX_LEN + 1];
+        uint32_t second;
+        uint32_t prepareUs;
+        PicFrameKind kind;
+        uint8_t length;
+        bool ready;
+    };
+    Slot slot_[2];
+    uint8_t front_;
+};
@@ -0,0 +1,60 @@
+#include "Histogram.h"
+
+#include <stdio.h>
+
+Histogram::Histogram(const int32_t *edges, uint8_t edgeCount)
+    : edges_(edges), edgeCount_(edgeCount > HIST_MAX_EDGES ? HIST_MAX_EDGES : edgeCount) {
+    reset();
+}
+
+void Histogram::reset() {
+    for (uint8_t i = 0; i <= HIST_MAX_EDGES; i++) {
+        counts_[i] = 0;
+    }
+    count_ = 0;
+    sum_ = 0;
+    min_ = 0;
+    max_ = 0;
+}
+
+void Histogram::add(int32_t value) {
+    uint8_t i = 0;
+    while (i < edgeCount_ && value >= edges_[i]) {
+        i++;
+    }
+    counts_[i]++;
+
+    if (count_ == 0 || value < min_) min_ = value;
+    if (count_ == 0 || value > max_) max_ = value;
+    count_++;
+    sum_ += value;
+}
+
+int32_t Histogram::percentileBound(uint8_t pct) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    uint64_t needed = ((uint64_t)count_ * pct + 99) / 100;
+    uint64_t seen = 0;
+    for (uint8_t i = 0; i < edgeCount_; i++) {
+        seen += counts_[i];
+        if (seen >= needed) {
+            return edges_[i];
+        }
+    }
+    return max_;
+}
+
+size_t Histogram::formatBucketLabel(uint8_t i, char *buf, size_t capacity) const {
+    int n;
+    if (edgeCount_ == 0) {
+        n = snprintf(buf, capacity, "tumu");
+    } else if (i == 0) {
+        n = snprintf(buf, capacity, "<%ld", (long)edges_[0]);
+    } else if (i >= edgeCount_) {
+        n = snprintf(buf, capacity, ">=%ld", (long)edges_[edgeCount_ - 1]);
+    } else {
+        n = snprintf(buf, capacity, "%ld..%ld", (long)edges_[i - 1], (long)edges_[i]);
+    }
+    return n < 0 ? 0 : ((size_t)n < capacity ? (size_t)n : capacity - 1);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+//================================================================================
+// SABIT BELLEKLI HISTOGRAM
+//================================================================================
+// Kova sinirlari disaridan (statik dizi) verilir; N sinir N+1 kova olusturur:
+//   kova 0: v < edges[0], kova i: edges[i-1] <= v < edges[i], son kova: v >= edges[N-1]
+// Heap kullanmaz, kopyalanabilir duz veridir (SeqLock ile yayinlanabilir).
+
+#define HIST_MAX_EDGES 15
+
+class Histogram {
+public:
+    Histogram() : edges_(0), edgeCount_(0) { reset(); }
+    Histogram(const int32_t *edges, uint8_t edgeCount);
+
+    void reset();
+    void add(int32_t value);
+
+    uint8_t bucketCount() const { return edgeCount_ + 1; }
+    uint32_t bucket(uint8_t i) const { return i <= edgeCount_ ? counts_[i] : 0; }
+    uint8_t edgeCount() const { return edgeCount_; }
+    int32_t edge(uint8_t i) const { return i < edgeCount_ ? edges_[i] : 0; }
+
+    uint32_t count() const { return count_; }
+    int64_t sum() const { return sum_; }
+    int32_t minValue() const { return count_ ? min_ : 0; }
+    int32_t maxValue() const { return count_ ? max_ : 0; }
+    int32_t mean() const { return count_ ? (int32_t)(sum_ / (int64_t)count_) : 0; }
+
+    // Orneklerin pct yuzdesinin altinda kaldigi kovanin ust siniri. Son
+    // kovaya duserse gozlenen en buyuk deger dondurulur.
+    int32_t percentileBound(uint8_t pct) const;
+
+    // "<-2000", "-2000..-1000", ">=2000" biciminde kova etiketi
+    size_t formatBucketLabel(uint8_t i, char *buf, size_t capacity) const;
+
+private:
+    const int32_t *edges_;
+    uint8_t edgeCount_;
+    uint32_t counts_[HIST_MAX_EDGES + 1];
+    uint32_t count_;
+    int64_t sum_;
+    int32_t min_;
+    int32_t max_;
+};
+
+#define HIST_EDGE_COUNT(edges) ((uint8_t)(sizeof(edges) / sizeof((edges)[0])))
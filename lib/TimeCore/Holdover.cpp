@@ -0,0 +1,58 @@
+#include "Holdover.h"
+
+HoldoverTracker::HoldoverTracker() : maxErrorUs_(HOLDOVER_DEFAULT_MAX_ERROR_US) {
+    reset();
+}
+
+void HoldoverTracker::reset() {
+    baseErrorUs_ = 0;
+    lastSyncLocalUs_ = 0;
+    holdoverSinceUs_ = 0;
+    hasSync_ = false;
+    holdover_ = false;
+}
+
+void HoldoverTracker::setMaxErrorUs(uint32_t maxErrorUs) {
+    if (maxErrorUs < HOLDOVER_MIN_MAX_ERROR_US) {
+        maxErrorUs = HOLDOVER_MIN_MAX_ERROR_US;
+    }
+    if (maxErrorUs > HOLDOVER_MAX_MAX_ERROR_US) {
+        maxErrorUs = HOLDOVER_MAX_MAX_ERROR_US;
+    }
+    maxErrorUs_ = maxErrorUs;
+}
+
+void HoldoverTracker::synced(int64_t localUs, uint32_t baseErrorUs) {
+    baseErrorUs_ = baseErrorUs;
+    lastSyncLocalUs_ = localUs;
+    hasSync_ = true;
+    holdover_ = false;
+}
+
+bool HoldoverTracker::enter(int64_t localUs) {
+    if (holdover_) {
+        return false;
+    }
+    holdover_ = true;
+    holdoverSinceUs_ = localUs;
+    return true;
+}
+
+uint32_t HoldoverTracker::errorBoundUs(int64_t localUs) const {
+    if (!hasSync_) {
+        return UINT32_MAX;
+    }
+    int64_t elapsedUs = localUs - lastSyncLocalUs_;
+    if (elapsedUs < 0) {
+        elapsedUs = 0;
+    }
+    int64_t bound = (int64_t)baseErrorUs_ + elapsedUs * HOLDOVER_WANDER_PPB / 1000000000LL;
+    return bound > (int64_t)UINT32_MAX ? UINT32_MAX : (uint32_t)bound;
+}
+
+ClockQuality HoldoverTracker::quality(int64_t localUs) const {
+    if (!hasSync_ || errorBoundUs(localUs) > maxErrorUs_) {
+        return CLOCK_UNLOCKED;
+    }
+    return holdover_ ? CLOCK_HOLDOVER : CLOCK_LOCKED;
+}
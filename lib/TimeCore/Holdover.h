@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+
+//================================================================================
+// HOLDOVER (KAYNAKSIZ ZAMAN TUTMA)
+//================================================================================
+// Ag ya da NTP kesildiginde disiplinli saat son frekans tahminiyle calismaya
+// devam eder. Hata siniri (dispersion) son basarili senkronizasyondaki
+// hatadan baslar ve gecen sureyle dogrusal buyur (RFC 5905 PHI mantigi).
+// Sinir esigi astiginda saat guvenilmez sayilir ve durum kodlarina donulur.
+//
+// Duz veridir; ag gorevi yazar, zaman kopyasiyla (seqlock) yayinlanir ve
+// cikis gorevi kendi anindaki kaliteyi hesaplar.
+
+#define HOLDOVER_WANDER_PPB             1000    // Frekans tahmininin kalan hatasi (1 ppm)
+#define HOLDOVER_DEFAULT_MAX_ERROR_US   10000   // Bu sinirin ustunde holdover biter
+#define HOLDOVER_MIN_MAX_ERROR_US       1000
+#define HOLDOVER_MAX_MAX_ERROR_US       1000000
+
+enum ClockQuality {
+    CLOCK_UNLOCKED,     // Hic senkron yok ya da hata siniri esigi asti
+    CLOCK_HOLDOVER,     // Kaynak yok, sinir esigin altinda
+    CLOCK_LOCKED        // Kaynaklar erisilebilir, son tur basarili
+};
+
+class HoldoverTracker {
+public:
+    HoldoverTracker();
+
+    void reset();
+    void setMaxErrorUs(uint32_t maxErrorUs);
+    uint32_t maxErrorUs() const { return maxErrorUs_; }
+
+    // Basarili tur: sinir baseErrorUs'e doner, holdover biter
+    void synced(int64_t localUs, uint32_t baseErrorUs);
+    // Kaynak kaybi (baglanti yok ya da tur basarisiz). Ilk cagrida true.
+    bool enter(int64_t localUs);
+
+    bool hasSync() const { return hasSync_; }
+    bool inHoldover() const { return holdover_; }
+    int64_t holdoverSinceUs() const { return holdoverSinceUs_; }
+    int64_t lastSyncLocalUs() const { return lastSyncLocalUs_; }
+
+    uint32_t errorBoundUs(int64_t localUs) const;
+    ClockQuality quality(int64_t localUs) const;
+
+private:
+    uint32_t maxErrorUs_;
+    uint32_t baseErrorUs_;
+    int64_t lastSyncLocalUs_;
+    int64_t holdoverSinceUs_;
+    bool hasSync_;
+    bool holdover_;
+};
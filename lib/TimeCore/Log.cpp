@@ -0,0 +1,61 @@
+#include "Log.h"
+
+#include <stdio.h>
+
+LogRing logRing;
+
+static MonotonicClock *logClock = 0;
+
+static const char *const TAG_NAMES[LOG_TAG_COUNT] = {
+    "SYS", "NTP", "SYNC", "→dsPIC", "NET", "WDT", "MASTER"
+};
+
+static const char LEVEL_CHARS[] = { 'E', 'W', 'I', 'D' };
+
+void logSetClock(MonotonicClock *clock) {
+    logClock = clock;
+}
+
+void logEvent(uint8_t level, uint8_t tag, const char *format,
+              uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+    LogEvent event;
+    event.timestampUs = logClock != 0 ? logClock->nowUs() : 0;
+    event.format = format;
+    event.args[0] = a0;
+    event.args[1] = a1;
+    event.args[2] = a2;
+    event.args[3] = a3;
+    event.level = level;
+    event.tag = tag;
+    logRing.push(event);
+}
+
+const char *logTagName(uint8_t tag) {
+    return tag < LOG_TAG_COUNT ? TAG_NAMES[tag] : "?";
+}
+
+size_t logFormat(const LogEvent &event, char *buf, size_t capacity) {
+    if (capacity == 0) {
+        return 0;
+    }
+
+    unsigned long ms = (unsigned long)(event.timestampUs / 1000);
+    int n = snprintf(buf, capacity, "%6lu.%03lu %c [%s] ",
+                     ms / 1000, ms % 1000,
+                     event.level <= LOG_LEVEL_DEBUG ? LEVEL_CHARS[event.level] : '?',
+                     logTagName(event.tag));
+    if (n < 0 || (size_t)n >= capacity) {
+        return capacity - 1;
+    }
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+    int m = snprintf(buf + n, capacity - n, event.format,
+                     event.args[0], event.args[1], event.args[2], event.args[3]);
+#pragma GCC diagnostic pop
+    if (m < 0) {
+        return (size_t)n;
+    }
+    return (size_t)n + (size_t)m >= capacity ? capacity - 1 : (size_t)(n + m);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "LogRing.h"
+#include "TimeHal.h"
+
+//================================================================================
+// ASENKRON LOG
+//================================================================================
+// LOGE/LOGW/LOGI/LOGD olaylari halkaya yazar ve hemen doner. Metin dusuk
+// oncelikli bir gorevde logFormat() ile uretilip seri porta basilir.
+//
+// LOG_MIN_LEVEL (platformio.ini build_flags) altindaki seviyeler derleme
+// zamaninda tamamen cikarilir; arguman ifadeleri bile derlenmez.
+// Bicim dizgisinde yalnizca 32 bit tam sayi donusumleri kullanilmalidir
+// (%d %u %ld %lu %x %c); %s ve kayan nokta desteklenmez.
+//
+// IPv4 adresi dort oktet arguman olarak verilir:
+//   LOGI(tag, "%u.%u.%u.%u", LOG_IPV4(ip))
+
+#define LOG_IPV4(ip) \
+    ((uint32_t)(ip) >> 24), (((uint32_t)(ip) >> 16) & 0xFF), (((uint32_t)(ip) >> 8) & 0xFF), ((uint32_t)(ip) & 0xFF)
+
+#define LOG_LEVEL_ERROR 0
+#define LOG_LEVEL_WARN  1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_DEBUG 3
+
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL LOG_LEVEL_INFO
+#endif
+
+enum LogTag : uint8_t {
+    LOG_TAG_SYS,
+    LOG_TAG_NTP,
+    LOG_TAG_SYNC,
+    LOG_TAG_PIC,
+    LOG_TAG_NET,
+    LOG_TAG_WDT,
+    LOG_TAG_MASTER,
+    LOG_TAG_COUNT
+};
+
+extern LogRing logRing;
+
+void logSetClock(MonotonicClock *clock);
+void logEvent(uint8_t level, uint8_t tag, const char *format,
+              uint32_t a0 = 0, uint32_t a1 = 0, uint32_t a2 = 0, uint32_t a3 = 0);
+const char *logTagName(uint8_t tag);
+
+// "  12.345 I [NTP] ..." biciminde satir uretir, yazilan uzunlugu dondurur
+size_t logFormat(const LogEvent &event, char *buf, size_t capacity);
+
+#if LOG_MIN_LEVEL >= LOG_LEVEL_ERROR
+#define LOGE(tag, ...) logEvent(LOG_LEVEL_ERROR, (tag), __VA_ARGS__)
+#else
+#define LOGE(tag, ...) do {} while (0)
+#endif
+
+#if LOG_MIN_LEVEL >= LOG_LEVEL_WARN
+#define LOGW(tag, ...) logEvent(LOG_LEVEL_WARN, (tag), __VA_ARGS__)
+#else
+#define LOGW(tag, ...) do {} while (0)
+#endif
+
+#if LOG_MIN_LEVEL >= LOG_LEVEL_INFO
+#define LOGI(tag, ...) logEvent(LOG_LEVEL_INFO, (tag), __VA_ARGS__)
+#else
+#define LOGI(tag, ...) do {} while (0)
+#endif
+
+#if LOG_MIN_LEVEL >= LOG_LEVEL_DEBUG
+#define LOGD(tag, ...) logEvent(LOG_LEVEL_DEBUG, (tag), __VA_ARGS__)
+#else
+#define LOGD(tag, ...) do {} while (0)
+#endif
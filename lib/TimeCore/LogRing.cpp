@@ -0,0 +1,49 @@
+#include "LogRing.h"
+
+#define LOG_RING_MASK (LOG_RING_CAPACITY - 1)
+
+static_assert((LOG_RING_CAPACITY & LOG_RING_MASK) == 0, "LOG_RING_CAPACITY 2'nin kuvveti olmali");
+
+LogRing::LogRing() : enqueuePos_(0), dequeuePos_(0), dropped_(0) {
+    for (uint32_t i = 0; i < LOG_RING_CAPACITY; i++) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool LogRing::push(const LogEvent &event) {
+    uint32_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+        cell = &cells_[pos & LOG_RING_MASK];
+        uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+        int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->event = event;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool LogRing::pop(LogEvent &out) {
+    uint32_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    Cell *cell = &cells_[pos & LOG_RING_MASK];
+    uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+    if ((int32_t)(seq - (pos + 1)) < 0) {
+        return false;
+    }
+
+    out = cell->event;
+    cell->sequence.store(pos + LOG_RING_CAPACITY, std::memory_order_release);
+    dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
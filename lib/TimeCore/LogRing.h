@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+//================================================================================
+// KILITSIZ LOG HALKASI
+//================================================================================
+// Cok ureticili / tek tuketicili sinirli kuyruk. Ureticiler (gonderim,
+// NTP, ag gorevleri) hicbir zaman beklemez; halka doluysa olay dusurulur ve
+// sayilir. Olaylar ikili saklanir, metne donusturme tuketici gorevde yapilir.
+
+#define LOG_RING_CAPACITY   64      // 2'nin kuvveti olmali
+#define LOG_MAX_ARGS        4
+
+struct LogEvent {
+    int64_t timestampUs;
+    const char *format;             // Kalici (literal) bicim dizgisi
+    uint32_t args[LOG_MAX_ARGS];    // Yalnizca 32 bit tam sayi argumanlar
+    uint8_t level;
+    uint8_t tag;
+};
+
+class LogRing {
+public:
+    LogRing();
+
+    // Her gorevden cagrilabilir; doluysa false doner ve dusurme sayilir
+    bool push(const LogEvent &event);
+
+    // Yalnizca tek tuketici gorevden cagrilmalidir
+    bool pop(LogEvent &out);
+
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        LogEvent event;
+    };
+
+    Cell cells_[LOG_RING_CAPACITY];
+    std::atomic<uint32_t> enqueuePos_;
+    std::atomic<uint32_t> dequeuePos_;
+    std::atomic<uint32_t> dropped_;
+};
@@ -0,0 +1,80 @@
+#include "LoopProfiler.h"
+
+#include <string.h>
+
+// Gorev turlari mikrosaniyelerden (bos tur) onlarca milisaniyeye (seri
+// konsol baskisi, DNS) kadar uzanir
+static const int32_t PROFILE_EDGES_US[] = {
+    5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000
+};
+
+static uint32_t clampU32(int64_t v) {
+    if (v < 0) return 0;
+    if (v > INT32_MAX) return INT32_MAX;
+    return (uint32_t)v;
+}
+
+LoopProfiler::LoopProfiler(const char *const *names, uint8_t stageCount, uint32_t stallThresholdUs)
+    : names_(names),
+      stageCount_(stageCount > PROFILE_MAX_STAGES ? PROFILE_MAX_STAGES : stageCount),
+      stallThresholdUs_(stallThresholdUs) {
+    reset();
+}
+
+void LoopProfiler::reset() {
+    for (uint8_t i = 0; i < PROFILE_MAX_STAGES; i++) {
+        stages_[i] = Histogram(PROFILE_EDGES_US, HIST_EDGE_COUNT(PROFILE_EDGES_US));
+    }
+    pass_ = Histogram(PROFILE_EDGES_US, HIST_EDGE_COUNT(PROFILE_EDGES_US));
+    memset(passStageUs_, 0, sizeof(passStageUs_));
+    memset(stalls_, 0, sizeof(stalls_));
+    passStartUs_ = 0;
+    lastMarkUs_ = 0;
+    stallCount_ = 0;
+}
+
+void LoopProfiler::beginPass(int64_t nowUs) {
+    passStartUs_ = nowUs;
+    lastMarkUs_ = nowUs;
+    memset(passStageUs_, 0, sizeof(passStageUs_));
+}
+
+void LoopProfiler::mark(uint8_t stage, int64_t nowUs) {
+    if (stage >= stageCount_) {
+        return;
+    }
+    // Ayni asama bir turda birden cok kez isaretlenebilir; sureler toplanir
+    passStageUs_[stage] += clampU32(nowUs - lastMarkUs_);
+    lastMarkUs_ = nowUs;
+}
+
+bool LoopProfiler::endPass(int64_t nowUs) {
+    uint32_t passUs = clampU32(nowUs - passStartUs_);
+    uint8_t longest = 0;
+    for (uint8_t i = 0; i < stageCount_; i++) {
+        stages_[i].add((int32_t)passStageUs_[i]);
+        if (passStageUs_[i] > passStageUs_[longest]) {
+            longest = i;
+        }
+    }
+    pass_.add((int32_t)passUs);
+
+    if (stallThresholdUs_ == 0 || passUs < stallThresholdUs_) {
+        return false;
+    }
+    ProfileStall &s = stalls_[stallCount_ % PROFILE_STALL_RING_LEN];
+    s.atUs = passStartUs_;
+    s.passUs = passUs;
+    s.stageUs = passStageUs_[longest];
+    s.stage = longest;
+    stallCount_++;
+    return true;
+}
+
+uint8_t LoopProfiler::stallsHeld() const {
+    return stallCount_ < PROFILE_STALL_RING_LEN ? (uint8_t)stallCount_ : PROFILE_STALL_RING_LEN;
+}
+
+const ProfileStall &LoopProfiler::stall(uint8_t i) const {
+    return stalls_[(stallCount_ - 1 - i) % PROFILE_STALL_RING_LEN];
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+#include "Histogram.h"
+
+//================================================================================
+// GOREV DONGUSU PROFILCISI
+//================================================================================
+// Bir gorev dongusunun her turu asamalara bolunur; mark() onceki isaretten
+// bu yana gecen sureyi verilen asamaya yazar. Asama basina ve tur basina
+// sabit kovali histogram (ortalama, maks, p99) tutulur. Turu esik degerini
+// asan her tur, en uzun suren asamasiyla birlikte kucuk bir halkaya girer.
+// Tek yazarlidir (sahibi olan gorev), duz veridir; SeqLock ile yayinlanir.
+
+#define PROFILE_MAX_STAGES      6
+#define PROFILE_STALL_RING_LEN  8
+
+struct ProfileStall {
+    int64_t atUs;           // Turun basladigi yerel an
+    uint32_t passUs;        // Turun toplam suresi
+    uint32_t stageUs;       // En uzun asamanin suresi
+    uint8_t stage;          // En uzun asama
+};
+
+class LoopProfiler {
+public:
+    LoopProfiler() : names_(0), stageCount_(0), stallThresholdUs_(0) { reset(); }
+    // names statik bir dizi olmalidir (yalnizca isaretci saklanir)
+    LoopProfiler(const char *const *names, uint8_t stageCount, uint32_t stallThresholdUs);
+
+    void reset();
+
+    void beginPass(int64_t nowUs);
+    void mark(uint8_t stage, int64_t nowUs);
+    // Tur esigi astiysa true (halkaya yazildi)
+    bool endPass(int64_t nowUs);
+
+    uint8_t stageCount() const { return stageCount_; }
+    const char *stageName(uint8_t stage) const { return stage < stageCount_ ? names_[stage] : "?"; }
+    const Histogram &stage(uint8_t stage) const { return stages_[stage < stageCount_ ? stage : 0]; }
+    const Histogram &pass() const { return pass_; }
+    uint32_t stallThresholdUs() const { return stallThresholdUs_; }
+
+    uint32_t stallCount() const { return stallCount_; }
+    // i = 0 en yenisi; halkada tutulan kayit sayisi kadar gecerlidir
+    uint8_t stallsHeld() const;
+    const ProfileStall &stall(uint8_t i) const;
+
+private:
+    const char *const *names_;
+    uint8_t stageCount_;
+    uint32_t stallThresholdUs_;
+    Histogram stages_[PROFILE_MAX_STAGES];
+    Histogram pass_;
+    uint32_t passStageUs_[PROFILE_MAX_STAGES];  // Suren turun asama sureleri
+    int64_t passStartUs_;
+    int64_t lastMarkUs_;
+    ProfileStall stalls_[PROFILE_STALL_RING_LEN];
+    uint32_t stallCount_;
+};
@@ -0,0 +1,66 @@
+#include "MasterCommandParser.h"
+
+#include <string.h>
+#include "TimeHal.h"
+
+void MasterCommandParser::reset() {
+    value_[0] = 0;
+    value_[1] = 0;
+    digitCount_ = 0;
+}
+
+bool MasterCommandParser::feed(char c, MasterCommand &out) {
+    if (isTerminator(c)) {
+        out.terminator = c;
+        out.digitCount = digitCount_;
+        out.octets[0] = (uint8_t)value_[0];
+        out.octets[1] = (uint8_t)value_[1];
+        out.valid = digitCount_ == MASTER_CMD_DIGITS && value_[0] <= 255 && value_[1] <= 255;
+        reset();
+        return true;
+    }
+
+    if (c >= '0' && c <= '9') {
+        if (digitCount_ < MASTER_CMD_DIGITS) {
+            uint8_t i = digitCount_ / 3;
+            value_[i] = (uint16_t)(value_[i] * 10 + (c - '0'));
+        }
+        if (digitCount_ < 255) {
+            digitCount_++;  // Fazla rakam komutu gecersiz kilar
+        }
+    }
+    return false;
+}
+
+void MasterConfigAssembler::clear() {
+    memset(octets_, 0, sizeof(octets_));
+    memset(halves_, 0, sizeof(halves_));
+}
+
+MasterConfigEvent MasterConfigAssembler::apply(const MasterCommand &cmd, uint8_t *serverIndex) {
+    uint8_t index = (cmd.terminator == 'u' || cmd.terminator == 'y') ? 0 : 1;
+    uint8_t half = (cmd.terminator == 'u' || cmd.terminator == 'w') ? 0 : 1;
+    if (serverIndex != 0) {
+        *serverIndex = index;
+    }
+    if (!cmd.valid) {
+        return MASTER_CFG_INVALID;
+    }
+
+    octets_[index][half * 2] = cmd.octets[0];
+    octets_[index][half * 2 + 1] = cmd.octets[1];
+    halves_[index] |= (uint8_t)(1 << half);
+
+    if (half == 0) {
+        return MASTER_CFG_FIRST_HALF;
+    }
+    return halves_[index] == 3 ? MASTER_CFG_ADDRESS : MASTER_CFG_SECOND_HALF;
+}
+
+uint32_t MasterConfigAssembler::server(uint8_t index) const {
+    if (index >= MASTER_NTP_SERVERS || halves_[index] != 3) {
+        return 0;
+    }
+    const uint8_t *o = octets_[index];
+    return makeIPv4(o[0], o[1], o[2], o[3]);
+}
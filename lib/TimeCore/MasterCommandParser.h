@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+
+//================================================================================
+// MASTER KART KOMUT AYRISTIRICI
+//================================================================================
+// Master kart NTP adreslerini rakam gruplari + sonlandirici harf olarak
+// gonderir: 192168u, 001002y (NTP1), 192169w, 001001x (NTP2). Her grup
+// 3 haneli iki oktettir.
+// Ayristirici bayt bayt beslenir ve rakamlari dogrudan oktet degerlerine
+// isler; metin tamponu ve heap kullanmaz. Rakam disi ve sonlandirici
+// olmayan karakterler yok sayilir.
+
+#define MASTER_CMD_DIGITS       6       // Komut basina rakam sayisi (2 oktet)
+#define MASTER_NTP_SERVERS      2
+
+struct MasterCommand {
+    char terminator;            // 'u', 'y', 'w' veya 'x'
+    uint8_t digitCount;         // Sonlandiriciya kadar gelen rakam sayisi
+    uint8_t octets[2];
+    bool valid;                 // Tam 6 rakam ve iki oktet de 0..255
+};
+
+class MasterCommandParser {
+public:
+    MasterCommandParser() { reset(); }
+
+    void reset();
+
+    // Komut tamamlandiginda out doldurulur ve true doner
+    bool feed(char c, MasterCommand &out);
+
+    static bool isTerminator(char c) { return c == 'u' || c == 'y' || c == 'w' || c == 'x'; }
+
+private:
+    uint16_t value_[2];
+    uint8_t digitCount_;
+};
+
+enum MasterConfigEvent {
+    MASTER_CFG_INVALID,         // Rakam sayisi ya da oktet araligi hatali
+    MASTER_CFG_FIRST_HALF,      // u / w: adresin ilk yarisi saklandi
+    MASTER_CFG_SECOND_HALF,     // y / x: ikinci yari saklandi, ilk yari eksik
+    MASTER_CFG_ADDRESS          // y / x: sunucu adresi tamamlandi
+};
+
+// Yarim adresleri birlestirip sunucu adreslerini ikili (host byte sirasi)
+// olarak tutar.
+class MasterConfigAssembler {
+public:
+    MasterConfigAssembler() { clear(); }
+
+    void clear();
+
+    // serverIndex: komutun ait oldugu sunucu (0: NTP1, 1: NTP2)
+    MasterConfigEvent apply(const MasterCommand &cmd, uint8_t *serverIndex);
+
+    // Iki yarisi da gelmisse adres, yoksa 0
+    uint32_t server(uint8_t index) const;
+    bool hasHalf(uint8_t index, uint8_t half) const {
+        return index < MASTER_NTP_SERVERS && half < 2 && (halves_[index] & (1 << half)) != 0;
+    }
+    uint8_t octet(uint8_t index, uint8_t i) const {
+        return index < MASTER_NTP_SERVERS && i < 4 ? octets_[index][i] : 0;
+    }
+
+private:
+    uint8_t octets_[MASTER_NTP_SERVERS][4];
+    uint8_t halves_[MASTER_NTP_SERVERS];    // bit0: ilk yari, bit1: ikinci yari
+};
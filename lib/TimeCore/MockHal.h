@@ -0,0 +1,181 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "TimeHal.h"
+
+//================================================================================
+// HOST (NATIVE) HAL UYGULAMALARI
+//================================================================================
+// env:native altinda zamanlama cekirdegini donanimsiz calistirmak icin.
+// Saat elle ilerletilir; UDP paketleri ayni saat uzerinden belirlenen
+// gecikmeyle teslim edilir; UART yazilari zaman damgasiyla kaydedilir.
+// Heap kullanilmaz, tum kuyruklar sabit boyutludur.
+
+class ManualClock : public MonotonicClock {
+public:
+    ManualClock() : nowUs_(0) {}
+
+    int64_t nowUs() override { return nowUs_; }
+    uint32_t millis() const { return (uint32_t)(nowUs_ / 1000); }
+    uint32_t micros() const { return (uint32_t)nowUs_; }
+
+    void set(int64_t us) { nowUs_ = us; }
+    void advance(int64_t us) { nowUs_ += us; }
+
+private:
+    int64_t nowUs_;
+};
+
+#define MOCK_UDP_QUEUE_LEN  8
+#define MOCK_UDP_MAX_PACKET 64
+#define MOCK_UDP_MAX_PEERS  4
+
+// Uclar birbirine baglanir (connect); bir ucun send() cagrisi hedef adresteki
+// ucun kuyruguna oneWayDelayUs sonra okunabilir olarak duser. Bir istemci
+// birden cok sunucuya baglanabilir.
+class LoopbackUdp : public UdpTransport {
+public:
+    LoopbackUdp(MonotonicClock &clock, uint32_t localIp, uint16_t localPort)
+        : clock_(clock), peerCount_(0), localIp_(localIp), localPort_(localPort),
+          delayUs_(0), count_(0), dropNext_(false) {}
+
+    void connect(LoopbackUdp &peer) { addPeer(peer); peer.addPeer(*this); }
+    void setOneWayDelay(int64_t us) { delayUs_ = us; }
+    void dropNext() { dropNext_ = true; }
+    uint16_t localPort() const { return localPort_; }
+
+    bool send(uint32_t ip, uint16_t port, const uint8_t *data, size_t len) override {
+        LoopbackUdp *peer = 0;
+        for (uint8_t i = 0; i < peerCount_; i++) {
+            if (peers_[i]->localIp_ == ip && peers_[i]->localPort_ == port) peer = peers_[i];
+        }
+        if (peer == 0 || len > MOCK_UDP_MAX_PACKET) {
+            return false;
+        }
+        if (dropNext_) {
+            dropNext_ = false;
+            return true;    // Gonderildi sanilir, ag yolda dusurdu
+        }
+        return peer->enqueue(clock_.nowUs() + delayUs_, localIp_, localPort_, data, len);
+    }
+
+    size_t receive(uint8_t *buf, size_t cap, uint32_t *fromIp, uint16_t *fromPort) override {
+        int64_t now = clock_.nowUs();
+        for (uint8_t i = 0; i < count_; i++) {
+            if (queue_[i].deliverAtUs > now) continue;
+
+            Packet &p = queue_[i];
+            size_t n = p.len < cap ? p.len : cap;
+            memcpy(buf, p.data, n);
+            *fromIp = p.fromIp;
+            *fromPort = p.fromPort;
+
+            for (uint8_t j = i + 1; j < count_; j++) queue_[j - 1] = queue_[j];
+            count_--;
+            return n;
+        }
+        return 0;
+    }
+
+private:
+    struct Packet {
+        int64_t deliverAtUs;
+        uint32_t fromIp;
+        uint16_t fromPort;
+        uint8_t len;
+        uint8_t data[MOCK_UDP_MAX_PACKET];
+    };
+
+    void addPeer(LoopbackUdp &peer) {
+        if (peerCount_ < MOCK_UDP_MAX_PEERS) peers_[peerCount_++] = &peer;
+    }
+
+    bool enqueue(int64_t at, uint32_t ip, uint16_t port, const uint8_t *data, size_t len) {
+        if (count_ >= MOCK_UDP_QUEUE_LEN) return false;
+        Packet &p = queue_[count_++];
+        p.deliverAtUs = at;
+        p.fromIp = ip;
+        p.fromPort = port;
+        p.len = (uint8_t)len;
+        memcpy(p.data, data, len);
+        return true;
+    }
+
+    MonotonicClock &clock_;
+    LoopbackUdp *peers_[MOCK_UDP_MAX_PEERS];
+    uint8_t peerCount_;
+    uint32_t localIp_;
+    uint16_t localPort_;
+    int64_t delayUs_;
+    Packet queue_[MOCK_UDP_QUEUE_LEN];
+    uint8_t count_;
+    bool dropNext_;
+};
+
+#define MOCK_UART_CAPTURE_LEN 256
+
+// Yazilan her blogu yazildigi anla birlikte saklar; dolunca en eskinin
+// uzerine yazar. baud verilirse son durma bitinin ani da modellenir:
+// yazim + surucu gecikmesi + 10 bit/bayt seri aktarim.
+class CaptureUart : public SerialPort {
+public:
+    struct Write {
+        int64_t atUs;
+        int64_t doneUs;         // Son durma biti hattan cikti
+        uint8_t len;
+        char data[16];
+    };
+
+    explicit CaptureUart(MonotonicClock &clock, uint32_t baud = 0, uint32_t driverLatencyUs = 0)
+        : clock_(clock), baud_(baud), driverLatencyUs_(driverLatencyUs), total_(0) {}
+
+    size_t write(const uint8_t *data, size_t len) override {
+        Write &w = log_[total_ % MOCK_UART_CAPTURE_LEN];
+        w.atUs = clock_.nowUs();
+        w.doneUs = w.atUs;
+        if (baud_ > 0) {
+            w.doneUs += driverLatencyUs_ + (int64_t)len * 10 * 1000000 / baud_;
+        }
+        w.len = (uint8_t)(len < sizeof(w.data) ? len : sizeof(w.data));
+        memcpy(w.data, data, w.len);
+        total_++;
+        return len;
+    }
+
+    uint32_t count() const { return total_; }
+    const Write &last() const { return log_[(total_ + MOCK_UART_CAPTURE_LEN - 1) % MOCK_UART_CAPTURE_LEN]; }
+    void clear() { total_ = 0; }
+
+private:
+    MonotonicClock &clock_;
+    uint32_t baud_;
+    uint32_t driverLatencyUs_;
+    Write log_[MOCK_UART_CAPTURE_LEN];
+    uint32_t total_;
+};
+
+#define MOCK_PULSE_CAPTURE_LEN 64
+
+// Simule PPS arka ucu: her darbenin yukselen kenar anini saklar
+class CapturePulse : public PulseOutput {
+public:
+    explicit CapturePulse(MonotonicClock &clock) : clock_(clock), total_(0), widthUs_(0) {}
+
+    bool pulse(uint32_t widthUs) override {
+        edges_[total_ % MOCK_PULSE_CAPTURE_LEN] = clock_.nowUs();
+        widthUs_ = widthUs;
+        total_++;
+        return true;
+    }
+
+    uint32_t count() const { return total_; }
+    int64_t lastEdgeUs() const { return edges_[(total_ + MOCK_PULSE_CAPTURE_LEN - 1) % MOCK_PULSE_CAPTURE_LEN]; }
+    uint32_t widthUs() const { return widthUs_; }
+
+private:
+    MonotonicClock &clock_;
+    int64_t edges_[MOCK_PULSE_CAPTURE_LEN];
+    uint32_t total_;
+    uint32_t widthUs_;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+
+//================================================================================
+// NTP PAKET FORMATI (RFC 5905)
+//================================================================================
+#define NTP_PACKET_SIZE     48
+#define NTP_PORT            123
+#define NTP_UNIX_OFFSET     2208988800UL    // 1900 -> 1970 farki (saniye)
+
+#define NTP_MODE_CLIENT     3
+#define NTP_MODE_SERVER     4
+#define NTP_VERSION         4
+#define NTP_LEAP_NOSYNC     3
+
+// Paket icindeki alan ofsetleri
+#define NTP_OFF_LI_VN_MODE  0
+#define NTP_OFF_STRATUM     1
+#define NTP_OFF_POLL        2
+#define NTP_OFF_PRECISION   3
+#define NTP_OFF_ROOT_DELAY  4
+#define NTP_OFF_ROOT_DISP   8
+#define NTP_OFF_REF_ID      12
+#define NTP_OFF_REFERENCE   16
+#define NTP_OFF_ORIGINATE   24
+#define NTP_OFF_RECEIVE     32
+#define NTP_OFF_TRANSMIT    40
+
+inline uint32_t ntpReadU32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+inline void ntpWriteU32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+// 16.16 NTP kisa formati (kok gecikmesi/dagilimi) -> mikrosaniye
+inline uint32_t ntpShortToUs(const uint8_t *p) {
+    return (uint32_t)(((uint64_t)ntpReadU32(p) * 1000000) >> 16);
+}
+
+// Mikrosaniye -> 16.16 NTP kisa formati (yukari yuvarlanir, doyar)
+inline void ntpWriteShortUs(uint8_t *p, uint32_t us) {
+    uint64_t v = (((uint64_t)us << 16) + 999999) / 1000000;
+    ntpWriteU32(p, v > 0xFFFFFFFFULL ? 0xFFFFFFFFUL : (uint32_t)v);
+}
+
+// 32.32 NTP zaman damgasi -> Unix mikrosaniye. Saniye farki uint32 ile
+// alindigi icin 2036 era gecisinde de 2106'ya kadar dogru sonuc verir.
+inline int64_t ntpTimestampToUnixUs(const uint8_t *p) {
+    uint32_t seconds = ntpReadU32(p) - (uint32_t)NTP_UNIX_OFFSET;
+    uint32_t fraction = ntpReadU32(p + 4);
+    return (int64_t)seconds * 1000000 + (int64_t)(((uint64_t)fraction * 1000000) >> 32);
+}
+
+inline void ntpWriteTimestamp(uint8_t *p, int64_t unixUs) {
+    uint32_t seconds = (uint32_t)(unixUs / 1000000);
+    uint32_t micros = (uint32_t)(unixUs % 1000000);
+    ntpWriteU32(p, seconds + (uint32_t)NTP_UNIX_OFFSET);
+    ntpWriteU32(p + 4, (uint32_t)(((uint64_t)micros << 32) / 1000000));
+}
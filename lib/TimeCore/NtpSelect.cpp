@@ -0,0 +1,219 @@
+#include "NtpSelect.h"
+
+#include <string.h>
+
+static int64_t absI64(int64_t v) { return v < 0 ? -v : v; }
+
+static uint32_t isqrt64(uint64_t v) {
+    uint32_t root = 0;
+    for (uint32_t bit = 1UL << 31; bit != 0; bit >>= 1) {
+        uint32_t trial = root | bit;
+        if ((uint64_t)trial * trial <= v) root = trial;
+    }
+    return root;
+}
+
+static uint64_t squareClamped(int64_t v) {
+    uint64_t a = (uint64_t)absI64(v);
+    if (a > 0xFFFFFFFFULL) a = 0xFFFFFFFFULL;
+    return a * a;
+}
+
+void NtpPeerFilter::reset() {
+    memset(&best_, 0, sizeof(best_));
+    count_ = 0;
+}
+
+void NtpPeerFilter::add(const SntpSample &sample) {
+    if (count_ < NTP_FILTER_MAX_SAMPLES) {
+        offsets_[count_] = sample.offsetUs;
+    }
+    // En dusuk ag gecikmeli ornek en az asimetri hatasi tasir
+    if (count_ == 0 || sample.delayUs < best_.delayUs) {
+        best_ = sample;
+    }
+    if (count_ < NTP_FILTER_MAX_SAMPLES) {
+        count_++;
+    }
+}
+
+uint32_t NtpPeerFilter::jitterUs() const {
+    if (count_ < 2) {
+        return 0;
+    }
+    uint64_t sum = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        sum += squareClamped(offsets_[i] - best_.offsetUs) / (count_ - 1);
+    }
+    return isqrt64(sum);
+}
+
+void ntpMakeCandidate(uint8_t server, const SntpSample &sample, uint32_t jitterUs,
+                      NtpCandidate &out) {
+    uint64_t delay = (uint64_t)sample.rootDelayUs + (uint64_t)sample.delayUs;
+    if (delay < NTP_SELECT_MIN_DISP_US) {
+        delay = NTP_SELECT_MIN_DISP_US;
+    }
+    uint64_t dist = delay / 2 + sample.rootDispersionUs + jitterUs;
+
+    out.server = server;
+    out.localUs = sample.t1LocalUs + (sample.t4LocalUs - sample.t1LocalUs) / 2;
+    out.offsetUs = sample.offsetUs;
+    out.rootDistUs = dist > 0xFFFFFFFFULL ? 0xFFFFFFFFUL : (uint32_t)dist;
+    out.jitterUs = jitterUs;
+    out.truechimer = false;
+    out.survivor = false;
+}
+
+// Kesisim algoritmasinin uc noktasi: -1 alt, 0 orta, +1 ust
+struct SelectEdge {
+    int64_t value;
+    int8_t type;
+};
+
+bool ntpSelectAndCombine(NtpCandidate *cands, uint8_t count, NtpSelection &out) {
+    SelectEdge edges[SNTP_MAX_SERVERS * 3];
+    uint8_t edgeCount = 0;
+    uint8_t n = 0;
+
+    if (count > SNTP_MAX_SERVERS) {
+        count = SNTP_MAX_SERVERS;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        cands[i].truechimer = false;
+        cands[i].survivor = false;
+        if (cands[i].rootDistUs >= NTP_SELECT_MAX_DIST_US) {
+            continue;
+        }
+        int64_t r = cands[i].rootDistUs;
+        SelectEdge e[3] = {
+            { cands[i].offsetUs - r, -1 },
+            { cands[i].offsetUs, 0 },
+            { cands[i].offsetUs + r, 1 }
+        };
+        // Araya sokarak sirali tut (en fazla 3*SNTP_MAX_SERVERS eleman)
+        for (uint8_t k = 0; k < 3; k++) {
+            uint8_t j = edgeCount++;
+            while (j > 0 && edges[j - 1].value > e[k].value) {
+                edges[j] = edges[j - 1];
+                j--;
+            }
+            edges[j] = e[k];
+        }
+        n++;
+    }
+    if (n == 0) {
+        return false;
+    }
+
+    // Marzullo: en az n-allow araligin kesistigi [low, high] araligini ara;
+    // allow, falseticker sayisinin yarinin altinda kaldigi surece artar
+    int64_t low = 0;
+    int64_t high = 0;
+    bool found = false;
+    for (uint8_t allow = 0; 2 * allow < n; allow++) {
+        uint8_t midpoints = 0;
+        int chime = 0;
+        for (uint8_t i = 0; i < edgeCount; i++) {
+            chime -= edges[i].type;
+            if (chime >= n - allow) {
+                low = edges[i].value;
+                break;
+            }
+            if (edges[i].type == 0) midpoints++;
+        }
+        chime = 0;
+        for (int i = edgeCount - 1; i >= 0; i--) {
+            chime += edges[i].type;
+            if (chime >= n - allow) {
+                high = edges[i].value;
+                break;
+            }
+            if (edges[i].type == 0) midpoints++;
+        }
+        if (midpoints > allow) {
+            continue;
+        }
+        if (low < high) {
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    uint8_t survivors[SNTP_MAX_SERVERS];
+    uint8_t survivorCount = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (cands[i].rootDistUs >= NTP_SELECT_MAX_DIST_US ||
+            cands[i].offsetUs < low || cands[i].offsetUs > high) {
+            continue;
+        }
+        cands[i].truechimer = true;
+        survivors[survivorCount++] = i;
+    }
+    if (survivorCount == 0) {
+        return false;
+    }
+    out.truechimers = survivorCount;
+
+    // Kumeleme: secim jitter'i en buyuk olan adayi, bu jitter kalanlarin en
+    // kucuk kendi jitter'indan buyuk oldukca ve NMIN'in ustundeyken at
+    while (survivorCount > NTP_SELECT_MIN_CLUSTER) {
+        uint32_t maxSelJitter = 0;
+        uint8_t worst = 0;
+        uint32_t minPeerJitter = 0xFFFFFFFFUL;
+        for (uint8_t i = 0; i < survivorCount; i++) {
+            const NtpCandidate &c = cands[survivors[i]];
+            uint64_t sum = 0;
+            for (uint8_t j = 0; j < survivorCount; j++) {
+                sum += squareClamped(cands[survivors[j]].offsetUs - c.offsetUs);
+            }
+            uint32_t selJitter = isqrt64(sum / (survivorCount - 1));
+            if (selJitter > maxSelJitter) {
+                maxSelJitter = selJitter;
+                worst = i;
+            }
+            if (c.jitterUs < minPeerJitter) {
+                minPeerJitter = c.jitterUs;
+            }
+        }
+        if (maxSelJitter <= minPeerJitter) {
+            break;
+        }
+        for (uint8_t i = worst + 1; i < survivorCount; i++) {
+            survivors[i - 1] = survivors[i];
+        }
+        survivorCount--;
+    }
+
+    // Birlestirme: 1/kok mesafesi agirlikli ortalama. Buyuk ofset
+    // degerleri ilk kalana gore farkla toplanir.
+    const NtpCandidate &base = cands[survivors[0]];
+    int64_t weightedSum = 0;
+    int64_t weightTotal = 0;
+    uint8_t systemPeer = survivors[0];
+    for (uint8_t i = 0; i < survivorCount; i++) {
+        NtpCandidate &c = cands[survivors[i]];
+        c.survivor = true;
+        int64_t weight = 1000000 / (c.rootDistUs > 0 ? c.rootDistUs : 1);
+        if (weight < 1) weight = 1;
+        weightedSum += (c.offsetUs - base.offsetUs) * weight;
+        weightTotal += weight;
+        if (c.rootDistUs < cands[systemPeer].rootDistUs) {
+            systemPeer = survivors[i];
+        }
+    }
+    out.offsetUs = base.offsetUs + weightedSum / weightTotal;
+    out.localUs = cands[systemPeer].localUs;
+    out.survivors = survivorCount;
+    out.systemPeer = cands[systemPeer].server;
+
+    uint64_t spread = 0;
+    for (uint8_t i = 0; i < survivorCount; i++) {
+        spread += squareClamped(cands[survivors[i]].offsetUs - out.offsetUs);
+    }
+    out.systemJitterUs = isqrt64(spread / survivorCount);
+    return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+#include "SntpEngine.h"
+
+//================================================================================
+// NTP SUNUCU SECIMI VE BIRLESTIRME (RFC 5905 11.2)
+//================================================================================
+// Bir turdaki her sunucunun ornekleri NtpPeerFilter'da toplanir (en dusuk
+// gecikmeli ornek + jitter). Tur sonunda adaylar kesisim (Marzullo)
+// algoritmasindan gecirilir, dogruluk araligi cogunlukla kesismeyen
+// sunucular (falseticker) atilir, kalanlar kumelenir ve kok mesafesiyle
+// agirliklandirilarak tek bir ofsete birlestirilir. Sunucu sayisi yalnizca
+// SNTP_MAX_SERVERS ile sinirlidir.
+
+#define NTP_SELECT_MIN_DISP_US  1000        // MINDISP
+#define NTP_SELECT_MAX_DIST_US  1500000     // MAXDIST: ustundeki adaylar secime girmez
+#define NTP_SELECT_MIN_CLUSTER  3           // NMIN: kumeleme bu sayinin altina inmez
+#define NTP_FILTER_MAX_SAMPLES  8
+
+class NtpPeerFilter {
+public:
+    NtpPeerFilter() { reset(); }
+
+    void reset();
+    void add(const SntpSample &sample);
+
+    bool hasSample() const { return count_ > 0; }
+    const SntpSample &best() const { return best_; }
+    // Ornek ofsetlerinin en iyi ornege gore karesel ortalamasi
+    uint32_t jitterUs() const;
+
+private:
+    SntpSample best_;
+    int64_t offsets_[NTP_FILTER_MAX_SAMPLES];
+    uint8_t count_;
+};
+
+struct NtpCandidate {
+    uint8_t server;             // SntpEngine sunucu sirasi
+    int64_t localUs;            // Olcumun yerel ani (T1-T4 ortasi)
+    int64_t offsetUs;           // UTC = yerel + offsetUs
+    uint32_t rootDistUs;        // Dogruluk araligi yaricapi (root distance)
+    uint32_t jitterUs;
+    bool truechimer;            // Orta noktasi kesisim araligina dustu
+    bool survivor;              // Kumelemeden sonra birlestirmeye girdi
+};
+
+void ntpMakeCandidate(uint8_t server, const SntpSample &sample, uint32_t jitterUs,
+                      NtpCandidate &out);
+
+struct NtpSelection {
+    int64_t localUs;            // Birlesik olcumun yerel ani (sistem sunucusu)
+    int64_t offsetUs;           // Kalanlarin agirlikli ortalamasi
+    uint32_t systemJitterUs;    // Kalanlarin birlesik ofsete gore dagilimi
+    uint8_t truechimers;
+    uint8_t survivors;
+    uint8_t systemPeer;         // En dusuk kok mesafeli kalan (sunucu sirasi)
+};
+
+// Adaylarin truechimer/survivor alanlarini doldurur. Adaylarin cogunlugu
+// ortak bir aralikta bulusamazsa false doner, out gecersizdir.
+bool ntpSelectAndCombine(NtpCandidate *cands, uint8_t count, NtpSelection &out);
@@ -0,0 +1,72 @@
+#include "PollController.h"
+
+PollController::PollController() {
+    reset();
+}
+
+void PollController::reset() {
+    exp_ = POLL_MIN_EXP;
+    jiggle_ = 0;
+    burstLeft_ = POLL_BURST_ROUNDS;
+    warmPending_ = false;
+}
+
+void PollController::warmStart(uint8_t exp) {
+    exp_ = exp < POLL_MIN_EXP ? POLL_MIN_EXP : (exp > POLL_MAX_EXP ? POLL_MAX_EXP : exp);
+    jiggle_ = 0;
+    burstLeft_ = POLL_WARM_BURST_ROUNDS;
+    warmPending_ = true;
+}
+
+void PollController::roundFailed() {
+    if (burstLeft_ > 0) {
+        burstLeft_--;
+    }
+}
+
+void PollController::update(DisciplineAction action, DisciplineState state,
+                            int64_t offsetUs, uint32_t jitterUs) {
+    if (burstLeft_ > 0) {
+        burstLeft_--;
+    }
+
+    // Sicak baslangicin ilk adimi yalnizca fazi kurar
+    if (warmPending_ && action == DISC_STEPPED && state == DISC_SYNC) {
+        warmPending_ = false;
+        return;
+    }
+    warmPending_ = false;
+
+    // Adim ya da frekans henuz olculmediyse en kisa araliga don
+    if (action == DISC_STEPPED || state != DISC_SYNC) {
+        exp_ = POLL_MIN_EXP;
+        jiggle_ = 0;
+        return;
+    }
+    if (action == DISC_IGNORED) {
+        return;
+    }
+
+    int64_t gate = (int64_t)POLL_PGATE * (jitterUs < POLL_JITTER_FLOOR_US ? POLL_JITTER_FLOOR_US : jitterUs);
+    int64_t absOffset = offsetUs < 0 ? -offsetUs : offsetUs;
+
+    if (absOffset < gate) {
+        jiggle_ += exp_;
+        if (jiggle_ > POLL_LIMIT) {
+            jiggle_ = POLL_LIMIT;
+            if (exp_ < POLL_MAX_EXP) {
+                exp_++;
+                jiggle_ = 0;
+            }
+        }
+    } else {
+        jiggle_ -= 2 * exp_;
+        if (jiggle_ < -POLL_LIMIT) {
+            jiggle_ = -POLL_LIMIT;
+            if (exp_ > POLL_MIN_EXP) {
+                exp_--;
+                jiggle_ = 0;
+            }
+        }
+    }
+}
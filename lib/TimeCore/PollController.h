@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+#include "ClockDiscipline.h"
+
+//================================================================================
+// UYARLANIR SORGU ARALIGI (RFC 5905 poll/jiggle)
+//================================================================================
+// Baslangicta ve saat adim ile ayarlandiginda kisa aralikli bir iburst
+// dizisi calisir. Disiplin dongusu yakinsadikca (|ofset| < PGATE*jitter)
+// jiggle sayaci artar ve aralik 2^minExp'ten 2^maxExp saniyeye kadar
+// ikiye katlanir; ofset jitter'a gore buyurse aralik geri kisalir.
+// Disiplin zaman sabiti araliga esit tutulur (tau = 2^poll).
+
+#define POLL_MIN_EXP            4       // 16 s (MINPOLL)
+#define POLL_MAX_EXP            10      // 1024 s (MAXPOLL)
+#define POLL_LIMIT              30      // Jiggle esigi (LIMIT)
+#define POLL_PGATE              4       // Yakinsama kapisi (PGATE)
+#define POLL_JITTER_FLOOR_US    50      // Cok kucuk jitter'da kapinin kapanmamasi icin
+#define POLL_BURST_ROUNDS       3       // Adim + frekans + ilk PLL turu
+#define POLL_BURST_INTERVAL_S   DISC_MIN_FREQ_INTERVAL_S
+#define POLL_WARM_BURST_ROUNDS  2       // Sicak baslangic: faz adimi + dogrulama
+
+class PollController {
+public:
+    PollController();
+
+    // Minimum araliga doner ve iburst baslatir
+    void reset();
+
+    // Onceki calismanin ussune doner; kisa iburst'teki ilk faz adimi
+    // araligi en kisaya dusurmez (frekans zaten biliniyor)
+    void warmStart(uint8_t exp);
+
+    // Tur sonunda disiplin sonucu ile cagrilir
+    void update(DisciplineAction action, DisciplineState state, int64_t offsetUs, uint32_t jitterUs);
+    // Tur olcum uretmedi (cevap yok / secim basarisiz)
+    void roundFailed();
+
+    bool inBurst() const { return burstLeft_ > 0; }
+    uint8_t pollExponent() const { return exp_; }
+    uint32_t intervalS() const { return inBurst() ? POLL_BURST_INTERVAL_S : (1UL << exp_); }
+    uint32_t intervalMs() const { return intervalS() * 1000UL; }
+    uint32_t timeConstantS() const { return 1UL << exp_; }
+    int8_t jiggle() const { return jiggle_; }
+
+private:
+    uint8_t exp_;
+    int8_t jiggle_;
+    uint8_t burstLeft_;
+    bool warmPending_;
+};
@@ -0,0 +1,11 @@
+#include "Pps.h"
+
+bool PpsGenerator::fire(uint32_t second) {
+    lastSecond_ = second;
+    if (!output_.pulse(widthUs_)) {
+        failures_++;
+        return false;
+    }
+    pulses_++;
+    return true;
+}
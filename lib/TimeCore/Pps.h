@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+#include "TimeHal.h"
+
+//================================================================================
+// SANIYE DARBESI (PPS)
+//================================================================================
+// Her disiplinli UTC saniyesinin basinda (yerel saatte +NTP_UTC_OFFSET_S ile
+// ayni an) bir darbe. Ardindan +TARGET_SEND_MS'te giden dsPIC karesi bu
+// darbenin saniyesini tasir: kare, kendinden onceki darbeyi etiketler.
+// Kenar anini cikis gorevi secer (zamanlayici + kisa bekleme); genislik
+// PulseOutput arka ucundadir.
+
+#define PPS_PULSE_WIDTH_US      10000
+
+class PpsGenerator {
+public:
+    explicit PpsGenerator(PulseOutput &output, uint32_t widthUs = PPS_PULSE_WIDTH_US)
+        : output_(output), widthUs_(widthUs), lastSecond_(0), pulses_(0), failures_(0) {}
+
+    // Saniye basi henuz darbelenmediyse ve en az minLeadUs uzaktaysa true
+    bool due(uint32_t second, int64_t nowUtcUs, uint32_t minLeadUs) const {
+        return second != lastSecond_ && nowUtcUs + minLeadUs <= (int64_t)second * 1000000;
+    }
+
+    static int64_t edgeUtcUs(uint32_t second) { return (int64_t)second * 1000000; }
+
+    // Kenar anina gelindi
+    bool fire(uint32_t second);
+
+    uint32_t lastSecond() const { return lastSecond_; }
+    uint32_t pulses() const { return pulses_; }
+    uint32_t failures() const { return failures_; }
+
+private:
+    PulseOutput &output_;
+    uint32_t widthUs_;
+    uint32_t lastSecond_;
+    uint32_t pulses_;
+    uint32_t failures_;
+};
@@ -0,0 +1,38 @@
+#include "SendScheduler.h"
+
+SendScheduler::SendScheduler(uint32_t targetOffsetUs)
+    : targetOffsetUs_(targetOffsetUs), pendingSecond_(0), lastSentSecond_(0),
+      sentCount_(0), missedSeconds_(0), duplicateSeconds_(0) {}
+
+int64_t SendScheduler::planNext(int64_t nowUtcUs, uint32_t minLeadUs) {
+    int64_t earliest = nowUtcUs + minLeadUs - targetOffsetUs_;
+    uint32_t second = (uint32_t)(earliest / 1000000);
+    if ((int64_t)second * 1000000 < earliest) {
+        second++;
+    }
+    if (lastSentSecond_ != 0 && second <= lastSentSecond_) {
+        second = lastSentSecond_ + 1;
+    }
+    pendingSecond_ = second;
+    return pendingTargetUtcUs();
+}
+
+void SendScheduler::markSent() {
+    if (lastSentSecond_ != 0) {
+        if (pendingSecond_ == lastSentSecond_) {
+            duplicateSeconds_++;
+        } else if (pendingSecond_ > lastSentSecond_ + 1) {
+            missedSeconds_ += pendingSecond_ - lastSentSecond_ - 1;
+        }
+    }
+    lastSentSecond_ = pendingSecond_;
+    sentCount_++;
+}
+
+void SendScheduler::markSkipped() {
+    // Atlanan saniye sonraki markSent() aradaki bosluktan sayilir; sira
+    // bilinmiyorsa (ilk gonderim) burada sayilir.
+    if (lastSentSecond_ == 0) {
+        missedSeconds_++;
+    }
+}
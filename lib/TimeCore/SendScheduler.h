@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+
+//================================================================================
+// dsPIC GONDERIM ZAMANLAYICISI
+//================================================================================
+// Her UTC saniyesinin +targetOffsetUs anini hedefler. Bir sonraki hedef
+// planNext() ile secilir, gonderim markSent()/markSkipped() ile kaydedilir.
+// Atlanan ve tekrarlanan saniyeler sayilir.
+
+class SendScheduler {
+public:
+    explicit SendScheduler(uint32_t targetOffsetUs);
+
+    // nowUtcUs'ten en az minLeadUs sonraki, daha once gonderilmemis ilk
+    // saniyenin hedef anini (UTC us) dondurur.
+    int64_t planNext(int64_t nowUtcUs, uint32_t minLeadUs);
+
+    uint32_t pendingSecond() const { return pendingSecond_; }
+    int64_t pendingTargetUtcUs() const {
+        return (int64_t)pendingSecond_ * 1000000 + targetOffsetUs_;
+    }
+
+    // Bekleyen saniye gonderildi
+    void markSent();
+    // Bekleyen saniye tolerans disinda kaldigi icin gonderilmedi
+    void markSkipped();
+    // Cikis durduruldu; yeniden basladiginda aradaki saniyeler sayilmaz
+    void resetSequence() { lastSentSecond_ = 0; }
+
+    uint32_t lastSentSecond() const { return lastSentSecond_; }
+    uint32_t sentCount() const { return sentCount_; }
+    uint32_t missedSeconds() const { return missedSeconds_; }
+    uint32_t duplicateSeconds() const { return duplicateSeconds_; }
+
+private:
+    uint32_t targetOffsetUs_;
+    uint32_t pendingSecond_;
+    uint32_t lastSentSecond_;
+    uint32_t sentCount_;
+    uint32_t missedSeconds_;
+    uint32_t duplicateSeconds_;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+//================================================================================
+// TEK YAZICILI SEQLOCK
+//================================================================================
+// Tek bir gorev yazar, istenen sayida gorev kilitsiz okur. Okuyucu yazici ile
+// cakisirsa kopyayi tekrarlar; yazici hicbir zaman beklemez. T kopyalanabilir
+// duz veri olmalidir (isaretci/heap icermemeli).
+
+template <typename T>
+class SeqLock {
+public:
+    SeqLock() : seq_(0), data_() {}
+
+    // Yalnizca tek bir uretici gorevden cagrilmalidir
+    void write(const T &value) {
+        uint32_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        data_ = value;
+        std::atomic_thread_fence(std::memory_order_release);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    // Tutarli bir kopya alinana kadar tekrarlar
+    void read(T &out) const {
+        while (!tryRead(out)) {
+        }
+    }
+
+    bool tryRead(T &out) const {
+        uint32_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        out = data_;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return seq_.load(std::memory_order_relaxed) == before;
+    }
+
+    // Her yazimda 2 artar; okuyucular degisiklik tespiti icin kullanabilir
+    uint32_t version() const { return seq_.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<uint32_t> seq_;
+    T data_;
+};
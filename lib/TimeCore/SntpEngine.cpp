@@ -0,0 +1,165 @@
+#include "SntpEngine.h"
+
+#include <string.h>
+
+SntpEngine::SntpEngine(UdpTransport &udp, MonotonicClock &clock)
+    : udp_(udp), clock_(clock), serverPort_(NTP_PORT),
+      timeoutUs_(SNTP_DEFAULT_TIMEOUT_US), status_(SNTP_IDLE), count_(0) {
+    memset(peers_, 0, sizeof(peers_));
+}
+
+void SntpEngine::setServers(const uint32_t *ips, uint8_t count, uint16_t port) {
+    if (count > SNTP_MAX_SERVERS) {
+        count = SNTP_MAX_SERVERS;
+    }
+    count_ = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (ips[i] == 0) {
+            continue;
+        }
+        memset(&peers_[count_], 0, sizeof(Peer));
+        peers_[count_].ip = ips[i];
+        peers_[count_].status = SNTP_IDLE;
+        count_++;
+    }
+    serverPort_ = port;
+    status_ = SNTP_IDLE;
+}
+
+bool SntpEngine::busy() const {
+    for (uint8_t i = 0; i < count_; i++) {
+        if (peers_[i].status == SNTP_PENDING) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SntpEngine::startRequest() {
+    if (busy() || count_ == 0) {
+        return false;
+    }
+
+    // Eski cevaplari at, yeni istege karismasinlar
+    uint8_t drain[NTP_PACKET_SIZE];
+    uint32_t fromIp;
+    uint16_t fromPort;
+    while (udp_.receive(drain, sizeof(drain), &fromIp, &fromPort) > 0) {
+    }
+
+    bool anySent = false;
+    for (uint8_t i = 0; i < count_; i++) {
+        Peer &peer = peers_[i];
+        uint8_t pkt[NTP_PACKET_SIZE];
+        memset(pkt, 0, sizeof(pkt));
+        pkt[NTP_OFF_LI_VN_MODE] = (NTP_LEAP_NOSYNC << 6) | (NTP_VERSION << 3) | NTP_MODE_CLIENT;
+
+        // Transmit alanina yerel zamani nonce olarak yaz; sunucu bunu originate
+        // alaninda geri dondurur, boylece eski/sahte cevaplar ayiklanir.
+        // Sunucu sirasi da karistirilir: ayni mikrosaniyede giden iki istek
+        // birbirinin cevabini kabul etmez.
+        int64_t now = clock_.nowUs();
+        peer.nonceHi = (uint32_t)((uint64_t)now >> 32);
+        peer.nonceLo = (uint32_t)now ^ (0x5A5A0000UL + ((uint32_t)i << 12));
+        ntpWriteU32(pkt + NTP_OFF_TRANSMIT, peer.nonceHi);
+        ntpWriteU32(pkt + NTP_OFF_TRANSMIT + 4, peer.nonceLo);
+
+        peer.sentAtUs = clock_.nowUs();
+        if (!udp_.send(peer.ip, serverPort_, pkt, sizeof(pkt))) {
+            peer.status = SNTP_SEND_FAILED;
+            continue;
+        }
+        peer.status = SNTP_PENDING;
+        anySent = true;
+    }
+
+    status_ = aggregateStatus();
+    return anySent;
+}
+
+SntpStatus SntpEngine::poll() {
+    if (!busy()) {
+        return status_;
+    }
+
+    uint8_t pkt[NTP_PACKET_SIZE];
+    uint32_t fromIp;
+    uint16_t fromPort;
+    size_t len;
+    while ((len = udp_.receive(pkt, sizeof(pkt), &fromIp, &fromPort)) > 0) {
+        int64_t recvUs = clock_.nowUs();
+        if (len < NTP_PACKET_SIZE || fromPort != serverPort_) {
+            continue;
+        }
+        for (uint8_t i = 0; i < count_; i++) {
+            Peer &peer = peers_[i];
+            if (peer.ip == fromIp && peer.status == SNTP_PENDING) {
+                if (acceptReply(peer, pkt, recvUs)) {
+                    peer.status = SNTP_COMPLETE;
+                }
+                break;
+            }
+        }
+    }
+
+    int64_t now = clock_.nowUs();
+    for (uint8_t i = 0; i < count_; i++) {
+        Peer &peer = peers_[i];
+        if (peer.status == SNTP_PENDING && now - peer.sentAtUs > (int64_t)timeoutUs_) {
+            peer.status = SNTP_TIMEOUT;
+        }
+    }
+
+    status_ = aggregateStatus();
+    return status_;
+}
+
+SntpStatus SntpEngine::aggregateStatus() const {
+    if (count_ == 0) {
+        return SNTP_IDLE;
+    }
+    bool anyComplete = false;
+    for (uint8_t i = 0; i < count_; i++) {
+        if (peers_[i].status == SNTP_PENDING) {
+            return SNTP_PENDING;
+        }
+        anyComplete |= peers_[i].status == SNTP_COMPLETE;
+    }
+    return anyComplete ? SNTP_COMPLETE : peers_[0].status;
+}
+
+bool SntpEngine::acceptReply(Peer &peer, const uint8_t *pkt, int64_t recvUs) {
+    uint8_t mode = pkt[NTP_OFF_LI_VN_MODE] & 0x07;
+    uint8_t leap = pkt[NTP_OFF_LI_VN_MODE] >> 6;
+    uint8_t stratum = pkt[NTP_OFF_STRATUM];
+
+    if (mode != NTP_MODE_SERVER || leap == NTP_LEAP_NOSYNC) return false;
+    // Stratum 0 = Kiss-o'-Death, 16 = senkronize degil
+    if (stratum == 0 || stratum >= 16) return false;
+    if (ntpReadU32(pkt + NTP_OFF_ORIGINATE) != peer.nonceHi ||
+        ntpReadU32(pkt + NTP_OFF_ORIGINATE + 4) != peer.nonceLo) return false;
+
+    if (ntpReadU32(pkt + NTP_OFF_TRANSMIT) == 0 || ntpReadU32(pkt + NTP_OFF_RECEIVE) == 0) return false;
+
+    int64_t t1 = peer.sentAtUs;
+    int64_t t2 = ntpTimestampToUnixUs(pkt + NTP_OFF_RECEIVE);
+    int64_t t3 = ntpTimestampToUnixUs(pkt + NTP_OFF_TRANSMIT);
+    int64_t t4 = recvUs;
+
+    // Sunucuda gecen sure negatif ya da toplam RTT'den buyuk olamaz
+    int64_t serverHold = t3 - t2;
+    int64_t delay = (t4 - t1) - serverHold;
+    if (serverHold < 0 || delay < 0) return false;
+
+    SntpSample &sample = peer.sample;
+    sample.t1LocalUs = t1;
+    sample.t2ServerUs = t2;
+    sample.t3ServerUs = t3;
+    sample.t4LocalUs = t4;
+    sample.offsetUs = ((t2 - t1) + (t3 - t4)) / 2;
+    sample.delayUs = delay;
+    sample.rootDelayUs = ntpShortToUs(pkt + NTP_OFF_ROOT_DELAY);
+    sample.rootDispersionUs = ntpShortToUs(pkt + NTP_OFF_ROOT_DISP);
+    sample.stratum = stratum;
+    return true;
+}
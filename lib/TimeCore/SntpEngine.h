@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stdint.h>
+#include "TimeHal.h"
+#include "NtpPacket.h"
+
+//================================================================================
+// BLOKLAMAYAN SNTP ISTEMCISI
+//================================================================================
+// startRequest() tum sunuculara ayni anda istek gonderip hemen doner;
+// cevaplar sonraki dongu turlarinda poll() ile toplanir ve tek soket
+// uzerinden kaynak adrese gore sunucusuna dagitilir. Gonderim yolu hicbir
+// zaman NTP sunucusunu beklemez.
+
+#define SNTP_MAX_SERVERS 4
+
+enum SntpStatus {
+    SNTP_IDLE,          // Bekleyen istek yok
+    SNTP_PENDING,       // Istek gonderildi, cevap bekleniyor
+    SNTP_COMPLETE,      // Gecerli cevap alindi, sample() hazir
+    SNTP_TIMEOUT,       // Zaman asimi, cevap gelmedi
+    SNTP_SEND_FAILED    // UDP gonderimi basarisiz
+};
+
+// RFC 5905 dort zaman damgasi. T1/T4 yerel monoton saatten (esp_timer),
+// T2/T3 sunucunun 32.32 alanlarindan mikrosaniye cozunurlukle alinir.
+struct SntpSample {
+    int64_t t1LocalUs;          // Istek gonderildi (yerel)
+    int64_t t2ServerUs;         // Sunucu istegi aldi (Unix us)
+    int64_t t3ServerUs;         // Sunucu cevabi gonderdi (Unix us)
+    int64_t t4LocalUs;          // Cevap alindi (yerel)
+    int64_t offsetUs;           // theta: UTC = yerel + offsetUs
+    int64_t delayUs;            // delta: gidis-donus ag gecikmesi
+    uint32_t rootDelayUs;       // Sunucunun referansina toplam gecikme
+    uint32_t rootDispersionUs;  // Sunucunun referansina gore hata payi
+    uint8_t stratum;
+};
+
+#define SNTP_DEFAULT_TIMEOUT_US 1000000
+
+class SntpEngine {
+public:
+    SntpEngine(UdpTransport &udp, MonotonicClock &clock);
+
+    // Sorgulanacak sunucular (en fazla SNTP_MAX_SERVERS). Bekleyen istekler
+    // iptal edilir.
+    void setServers(const uint32_t *ips, uint8_t count, uint16_t port = NTP_PORT);
+    void setServer(uint32_t ip, uint16_t port = NTP_PORT) { setServers(&ip, 1, port); }
+    void setTimeout(uint32_t timeoutUs) { timeoutUs_ = timeoutUs; }
+
+    // Tum sunuculara istek gonderir, cevap beklemez. Zaten bekleyen istek
+    // varsa ya da hicbir istek gonderilemediyse false.
+    bool startRequest();
+
+    // Gelen paketleri isler, zaman asimini kontrol eder. Bloklamaz.
+    // Herhangi bir sunucu bekliyorsa SNTP_PENDING, yoksa en az biri
+    // cevap verdiyse SNTP_COMPLETE, aksi halde ilk sunucunun durumu.
+    SntpStatus poll();
+
+    bool busy() const;
+    SntpStatus status() const { return status_; }
+    uint8_t serverCount() const { return count_; }
+    uint32_t serverIp(uint8_t i = 0) const { return i < count_ ? peers_[i].ip : 0; }
+    SntpStatus serverStatus(uint8_t i) const { return i < count_ ? peers_[i].status : SNTP_IDLE; }
+    const SntpSample &sample(uint8_t i) const { return peers_[i < count_ ? i : 0].sample; }
+    const SntpSample &lastSample() const { return peers_[0].sample; }
+
+private:
+    struct Peer {
+        uint32_t ip;
+        SntpStatus status;
+        int64_t sentAtUs;
+        uint32_t nonceHi;       // Originate alaninda geri donmesi gereken deger
+        uint32_t nonceLo;
+        SntpSample sample;
+    };
+
+    bool acceptReply(Peer &peer, const uint8_t *pkt, int64_t recvUs);
+    SntpStatus aggregateStatus() const;
+
+    UdpTransport &udp_;
+    MonotonicClock &clock_;
+    uint16_t serverPort_;
+    uint32_t timeoutUs_;
+    SntpStatus status_;
+    uint8_t count_;
+    Peer peers_[SNTP_MAX_SERVERS];
+};
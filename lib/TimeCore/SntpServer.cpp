@@ -0,0 +1,129 @@
+#include "SntpServer.h"
+
+#include <string.h>
+
+#define SNTP_SERVER_GLOBAL_REFILL_US (1000000 / SNTP_SERVER_RATE_PER_S)
+
+SntpServer::SntpServer(UdpTransport &udp, MonotonicClock &clock) : udp_(udp), clock_(clock) {
+    reset();
+}
+
+void SntpServer::reset() {
+    globalRefillAtUs_ = clock_.nowUs();
+    globalTokens_ = SNTP_SERVER_BURST;
+    memset(clients_, 0, sizeof(clients_));
+    for (uint8_t i = 0; i < SNTP_SERVER_CLIENT_SLOTS; i++) {
+        clients_[i].refillAtUs = globalRefillAtUs_;
+        clients_[i].tokens = SNTP_SERVER_CLIENT_BURST;
+    }
+    memset(&counters_, 0, sizeof(counters_));
+}
+
+uint8_t SntpServer::service(const ClockDiscipline &clock, const HoldoverTracker &holdover,
+                            const SntpReference &ref, uint8_t maxPackets) {
+    uint8_t handled = 0;
+    uint8_t pkt[NTP_PACKET_SIZE];
+    uint32_t fromIp;
+    uint16_t fromPort;
+
+    while (handled < maxPackets) {
+        size_t len = udp_.receive(pkt, sizeof(pkt), &fromIp, &fromPort);
+        if (len == 0) {
+            break;
+        }
+        int64_t receiveLocalUs = clock_.nowUs();
+        handled++;
+        counters_.requests++;
+
+        uint8_t mode = pkt[NTP_OFF_LI_VN_MODE] & 0x07;
+        uint8_t version = (pkt[NTP_OFF_LI_VN_MODE] >> 3) & 0x07;
+        if (len < NTP_PACKET_SIZE || mode != NTP_MODE_CLIENT || version < 1 || version > NTP_VERSION) {
+            counters_.malformed++;
+            continue;
+        }
+        if (!clock.isValid() || ref.stratum == 0 || holdover.quality(receiveLocalUs) == CLOCK_UNLOCKED) {
+            counters_.refused++;
+            continue;
+        }
+        if (!admit(fromIp, receiveLocalUs)) {
+            counters_.rateLimited++;
+            continue;
+        }
+        reply(pkt, receiveLocalUs, fromIp, fromPort, clock, holdover, ref);
+    }
+    return handled;
+}
+
+bool SntpServer::admit(uint32_t ip, int64_t nowUs) {
+    // Genel kova
+    int64_t elapsed = nowUs - globalRefillAtUs_;
+    if (elapsed >= SNTP_SERVER_GLOBAL_REFILL_US) {
+        int64_t add = elapsed / SNTP_SERVER_GLOBAL_REFILL_US;
+        int64_t tokens = globalTokens_ + add;
+        globalRefillAtUs_ += add * SNTP_SERVER_GLOBAL_REFILL_US;
+        globalTokens_ = tokens > SNTP_SERVER_BURST ? SNTP_SERVER_BURST : (uint32_t)tokens;
+    }
+    if (globalTokens_ == 0) {
+        return false;
+    }
+
+    // Istemci kovasi (Knuth carpimsal ozetinin ust bitleri)
+    ClientSlot &slot = clients_[(uint32_t)(ip * 2654435761UL) >> (32 - SNTP_SERVER_CLIENT_SLOT_BITS)];
+    int64_t clientElapsed = nowUs - slot.refillAtUs;
+    if (clientElapsed >= SNTP_SERVER_CLIENT_REFILL_US) {
+        int64_t add = clientElapsed / SNTP_SERVER_CLIENT_REFILL_US;
+        int64_t tokens = slot.tokens + add;
+        slot.refillAtUs += add * SNTP_SERVER_CLIENT_REFILL_US;
+        slot.tokens = tokens > SNTP_SERVER_CLIENT_BURST ? SNTP_SERVER_CLIENT_BURST : (uint8_t)tokens;
+    }
+    if (slot.ip != ip) {
+        // Yuvadaki istemci kovasini harciyorsa yuvayi korur; yeni gelen
+        // yalnizca genel kovaya tabidir. Boylece hizli bir istemci carpisan
+        // istemcilerle yer degistirerek her seferinde tam kova kazanamaz.
+        if (slot.tokens < SNTP_SERVER_CLIENT_BURST) {
+            globalTokens_--;
+            return true;
+        }
+        slot.ip = ip;
+        slot.refillAtUs = nowUs;
+    }
+    if (slot.tokens == 0) {
+        return false;
+    }
+
+    slot.tokens--;
+    globalTokens_--;
+    return true;
+}
+
+void SntpServer::reply(const uint8_t *request, int64_t receiveLocalUs, uint32_t ip, uint16_t port,
+                       const ClockDiscipline &clock, const HoldoverTracker &holdover,
+                       const SntpReference &ref) {
+    uint8_t out[NTP_PACKET_SIZE];
+    memset(out, 0, sizeof(out));
+
+    // LI 0: artik saniye bilgisi tutulmaz; surum istemcininki
+    uint8_t version = (request[NTP_OFF_LI_VN_MODE] >> 3) & 0x07;
+    out[NTP_OFF_LI_VN_MODE] = (uint8_t)((version << 3) | NTP_MODE_SERVER);
+    out[NTP_OFF_STRATUM] = ref.stratum >= SNTP_SERVER_MAX_STRATUM ? SNTP_SERVER_MAX_STRATUM : ref.stratum + 1;
+    out[NTP_OFF_POLL] = request[NTP_OFF_POLL];
+    out[NTP_OFF_PRECISION] = (uint8_t)(int8_t)SNTP_SERVER_PRECISION;
+
+    // Kok dagilimi: ust sunucununki + bizim hata sinirimiz (faz + jitter +
+    // yarim gecikme, holdover'da zamanla artan pay dahil)
+    uint64_t rootDisp = (uint64_t)ref.rootDispersionUs + holdover.errorBoundUs(receiveLocalUs);
+    ntpWriteShortUs(out + NTP_OFF_ROOT_DELAY, ref.rootDelayUs);
+    ntpWriteShortUs(out + NTP_OFF_ROOT_DISP, rootDisp > 0xFFFFFFFFULL ? 0xFFFFFFFFUL : (uint32_t)rootDisp);
+    ntpWriteU32(out + NTP_OFF_REF_ID, ref.refId);
+    ntpWriteTimestamp(out + NTP_OFF_REFERENCE, clock.toUtcUs(holdover.lastSyncLocalUs()));
+
+    memcpy(out + NTP_OFF_ORIGINATE, request + NTP_OFF_TRANSMIT, 8);
+    ntpWriteTimestamp(out + NTP_OFF_RECEIVE, clock.toUtcUs(receiveLocalUs));
+    ntpWriteTimestamp(out + NTP_OFF_TRANSMIT, clock.toUtcUs(clock_.nowUs()));
+
+    if (udp_.send(ip, port, out, sizeof(out))) {
+        counters_.replies++;
+    } else {
+        counters_.sendFailed++;
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdint.h>
+#include "TimeHal.h"
+#include "NtpPacket.h"
+#include "ClockDiscipline.h"
+#include "Holdover.h"
+
+//================================================================================
+// SNTP SUNUCUSU (RFC 4330 / 5905 sunucu modu)
+//================================================================================
+// Yerel agdaki panellere disiplinli saati dagitir. Istek (mod 3) alinir
+// alinmaz yerel an damgalanir, cevap ayni cagrida gonderilir; kuyruk,
+// heap ve bekleme yoktur. Saat kilitli degilse (UNLOCKED) istekler
+// cevapsiz atilir. Holdover'da cevap verilir, kok dagilimi buyur.
+//
+// Hiz siniri iki katmanlidir: genel jeton kovasi (SNTP_SERVER_RATE_PER_S)
+// ve dogrudan eslemeli istemci tablosunda istemci basina kova (kisa
+// iburst'e izin verir, surekli yuklemeyi keser). Tabloda cakisan istemci
+// yuvayi ancak eskisi kovasini doldurmussa (bosta ise) devralir; aksi
+// halde yalnizca genel kovaya tabidir. Sinir en iyi cabadir, bellek sabittir.
+
+#define SNTP_SERVER_RATE_PER_S          500
+#define SNTP_SERVER_BURST               64
+#define SNTP_SERVER_CLIENT_SLOT_BITS    6
+#define SNTP_SERVER_CLIENT_SLOTS        (1 << SNTP_SERVER_CLIENT_SLOT_BITS)
+#define SNTP_SERVER_CLIENT_BURST        4
+#define SNTP_SERVER_CLIENT_REFILL_US    1000000 // Istemci basina 1 istek/s
+#define SNTP_SERVER_PRECISION           -20     // log2(1 us), esp_timer cozunurlugu
+#define SNTP_SERVER_MAX_STRATUM         15
+
+// Sistem sunucusundan (system peer) devralinan referans bilgisi
+struct SntpReference {
+    uint32_t refId;             // Ust sunucunun IPv4 adresi
+    uint8_t stratum;            // Ust sunucunun stratum'u, 0: henuz yok
+    uint32_t rootDelayUs;       // Ust sunucunun kok gecikmesi + bize gidis-donus
+    uint32_t rootDispersionUs;  // Ust sunucunun kok dagilimi
+};
+
+struct SntpServerCounters {
+    uint32_t requests;
+    uint32_t replies;
+    uint32_t refused;           // Saat kilitli degil
+    uint32_t rateLimited;
+    uint32_t malformed;         // Kisa paket ya da istemci modu degil
+    uint32_t sendFailed;
+};
+
+class SntpServer {
+public:
+    SntpServer(UdpTransport &udp, MonotonicClock &clock);
+
+    void reset();
+
+    // Bekleyen en fazla maxPackets istegi cevaplar; bloklamaz. Islenen
+    // paket sayisini dondurur.
+    uint8_t service(const ClockDiscipline &clock, const HoldoverTracker &holdover,
+                    const SntpReference &ref, uint8_t maxPackets);
+
+    const SntpServerCounters &counters() const { return counters_; }
+
+private:
+    struct ClientSlot {
+        uint32_t ip;
+        int64_t refillAtUs;     // Son jetonun eklendigi an
+        uint8_t tokens;
+    };
+
+    bool admit(uint32_t ip, int64_t nowUs);
+    void reply(const uint8_t *request, int64_t receiveLocalUs, uint32_t ip, uint16_t port,
+               const ClockDiscipline &clock, const HoldoverTracker &holdover, const SntpReference &ref);
+
+    UdpTransport &udp_;
+    MonotonicClock &clock_;
+    int64_t globalRefillAtUs_;
+    uint32_t globalTokens_;
+    ClientSlot clients_[SNTP_SERVER_CLIENT_SLOTS];
+    SntpServerCounters counters_;
+};
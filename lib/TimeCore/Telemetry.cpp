@@ -0,0 +1,176 @@
+#include "Telemetry.h"
+
+#include <string.h>
+
+MetricsWriter::MetricsWriter(char *buf, size_t capacity)
+    : buf_(buf), capacity_(capacity), length_(0), lineStart_(0), lineFailed_(false), overflow_(false) {
+    if (capacity_ > 0) {
+        buf_[0] = '\0';
+    }
+}
+
+void MetricsWriter::put(const char *text) {
+    size_t len = strlen(text);
+    // Sonlandirici icin bir bayt ayrilir
+    if (lineFailed_ || length_ + len + 1 > capacity_) {
+        lineFailed_ = true;
+        return;
+    }
+    memcpy(buf_ + length_, text, len);
+    length_ += len;
+}
+
+void MetricsWriter::putInt(int64_t value) {
+    char digits[21];
+    uint8_t n = 0;
+    uint64_t magnitude = value < 0 ? (uint64_t)(-(value + 1)) + 1 : (uint64_t)value;
+    do {
+        digits[n++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    char text[22];
+    uint8_t len = 0;
+    if (value < 0) {
+        text[len++] = '-';
+    }
+    while (n > 0) {
+        text[len++] = digits[--n];
+    }
+    text[len] = '\0';
+    put(text);
+}
+
+void MetricsWriter::endLine() {
+    put("\n");
+    if (lineFailed_) {
+        // Yarim satir birakilmaz
+        length_ = lineStart_;
+        lineFailed_ = false;
+        overflow_ = true;
+    }
+    if (capacity_ > 0) {
+        buf_[length_] = '\0';
+    }
+}
+
+void MetricsWriter::family(const char *name, const char *type, const char *help) {
+    beginLine();
+    put("# HELP ");
+    put(name);
+    put(" ");
+    put(help);
+    endLine();
+
+    beginLine();
+    put("# TYPE ");
+    put(name);
+    put(" ");
+    put(type);
+    endLine();
+}
+
+void MetricsWriter::line(const char *name, const char *suffix, const char *labels, int64_t value) {
+    beginLine();
+    put(name);
+    put(suffix);
+    if (labels != NULL && labels[0] != '\0') {
+        put("{");
+        put(labels);
+        put("}");
+    }
+    put(" ");
+    putInt(value);
+    endLine();
+}
+
+void MetricsWriter::sample(const char *name, const char *labels, int64_t value) {
+    line(name, "", labels, value);
+}
+
+void MetricsWriter::gauge(const char *name, const char *help, int64_t value) {
+    family(name, "gauge", help);
+    sample(name, NULL, value);
+}
+
+void MetricsWriter::counter(const char *name, const char *help, uint32_t value) {
+    family(name, "counter", help);
+    sample(name, NULL, value);
+}
+
+void MetricsWriter::histogram(const char *name, const char *labels, const Histogram &hist) {
+    bool hasLabels = labels != NULL && labels[0] != '\0';
+    uint32_t cumulative = 0;
+
+    // Son kova (v >= son sinir) yalnizca +Inf'e girer
+    for (uint8_t i = 0; i < hist.bucketCount(); i++) {
+        cumulative += hist.bucket(i);
+        beginLine();
+        put(name);
+        put("_bucket{");
+        if (hasLabels) {
+            put(labels);
+            put(",");
+        }
+        put("le=\"");
+        if (i < hist.edgeCount()) {
+            putInt((int64_t)hist.edge(i) - 1);
+        } else {
+            put("+Inf");
+        }
+        put("\"} ");
+        putInt(cumulative);
+        endLine();
+    }
+    line(name, "_sum", labels, hist.sum());
+    line(name, "_count", labels, hist.count());
+}
+
+void HttpRequestReader::reset() {
+    line_[0] = '\0';
+    lineLength_ = 0;
+    currentLength_ = 0;
+    firstLine_ = true;
+    complete_ = false;
+}
+
+bool HttpRequestReader::feed(char c) {
+    if (complete_) {
+        return true;
+    }
+    if (c == '\r') {
+        return false;
+    }
+    if (c == '\n') {
+        if (firstLine_) {
+            firstLine_ = false;
+        } else if (currentLength_ == 0) {
+            complete_ = true;
+            return true;
+        }
+        currentLength_ = 0;
+        return false;
+    }
+
+    if (currentLength_ < UINT16_MAX) {
+        currentLength_++;
+    }
+    // Uzun istek satiri kesilir; yol eslesmesi icin bas kismi yeter
+    if (firstLine_ && lineLength_ < HTTP_REQUEST_LINE_MAX) {
+        line_[lineLength_++] = c;
+        line_[lineLength_] = '\0';
+    }
+    return false;
+}
+
+bool HttpRequestReader::isGet(const char *path) const {
+    if (strncmp(line_, "GET ", 4) != 0) {
+        return false;
+    }
+    size_t pathLen = strlen(path);
+    if (strncmp(line_ + 4, path, pathLen) != 0) {
+        return false;
+    }
+    char next = line_[4 + pathLen];
+    return next == ' ' || next == '?' || next == '\0';
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Histogram.h"
+
+//================================================================================
+// AG TELEMETRISI (PROMETHEUS METIN BICIMI)
+//================================================================================
+// Sayaclar istek geldiginde cagiranin verdigi sabit tampona yazilir; heap
+// kullanilmaz, yayinlanmis kopyalar (SeqLock) disinda hicbir seye dokunulmaz.
+// Her satir tampona butun olarak sigar ya da hic yazilmaz: tampon yetmezse
+// overflowed() true olur ama cikti her zaman gecerli satirlardan olusur.
+//
+// HTTP tarafi yalnizca "GET <yol>" isteklerini tanir: ilk satir saklanir,
+// diger basliklar okunup atilir, bos satirda istek tamamlanir.
+
+#define HTTP_REQUEST_LINE_MAX   64
+
+class MetricsWriter {
+public:
+    MetricsWriter(char *buf, size_t capacity);
+
+    // "# HELP" ve "# TYPE" satirlari; type "gauge", "counter" ya da "histogram"
+    void family(const char *name, const char *type, const char *help);
+
+    // labels NULL ya da 'server="1",dir="tx"' bicimindedir
+    void sample(const char *name, const char *labels, int64_t value);
+
+    void gauge(const char *name, const char *help, int64_t value);
+    void counter(const char *name, const char *help, uint32_t value);
+
+    // Prometheus histogrami: birikimli name_bucket{le=...}, name_sum, name_count.
+    // Kova i tam sayilar icin v < edges[i], yani v <= edges[i]-1 oldugundan
+    // le siniri edges[i]-1 yazilir; sayimlar kesindir.
+    void histogram(const char *name, const char *labels, const Histogram &hist);
+
+    size_t length() const { return length_; }
+    bool overflowed() const { return overflow_; }
+
+private:
+    void beginLine() { lineStart_ = length_; }
+    // name + suffix, varsa {labels} ve deger tek satir
+    void line(const char *name, const char *suffix, const char *labels, int64_t value);
+    void endLine();
+    void put(const char *text);
+    void putInt(int64_t value);
+
+    char *buf_;
+    size_t capacity_;
+    size_t length_;
+    size_t lineStart_;
+    bool lineFailed_;
+    bool overflow_;
+};
+
+class HttpRequestReader {
+public:
+    HttpRequestReader() { reset(); }
+
+    void reset();
+
+    // Basliklar bitince (bos satir) true
+    bool feed(char c);
+
+    // Istek satiri "GET <path>" ile basliyor mu (sorgu dizgesi yok sayilir)
+    bool isGet(const char *path) const;
+    bool complete() const { return complete_; }
+
+private:
+    char line_[HTTP_REQUEST_LINE_MAX + 1];
+    uint8_t lineLength_;
+    uint16_t currentLength_;    // Suren satirin uzunlugu (\r haric)
+    bool firstLine_;
+    bool complete_;
+};
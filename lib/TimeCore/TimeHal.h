@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+//================================================================================
+// ZAMANLAMA CEKIRDEGI - DONANIM SOYUTLAMASI
+//================================================================================
+// Zamanlama cekirdegi Arduino'ya dogrudan baglanmaz; UDP soketi, UART ve
+// monoton saat bu arayuzler uzerinden verilir. Karta ozel uygulamalar
+// src/EspTimeHal.cpp, host (native) uygulamalari MockHal.h icindedir.
+
+// IPv4 adresi host byte sirasinda tutulur: 192.168.1.2 -> 0xC0A80102
+inline uint32_t makeIPv4(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+    return ((uint32_t)a << 24) | ((uint32_t)b << 16) | ((uint32_t)c << 8) | (uint32_t)d;
+}
+
+// "192.168.1.2" bicimi; buf en az 16 bayt olmalidir
+inline void formatIPv4(uint32_t ip, char *buf, size_t capacity) {
+    snprintf(buf, capacity, "%u.%u.%u.%u",
+             (unsigned)(ip >> 24), (unsigned)((ip >> 16) & 0xFF),
+             (unsigned)((ip >> 8) & 0xFF), (unsigned)(ip & 0xFF));
+}
+
+class UdpTransport {
+public:
+    virtual ~UdpTransport() {}
+
+    // Tek bir datagram gonderir. Bloklamamalidir.
+    virtual bool send(uint32_t ip, uint16_t port, const uint8_t *data, size_t len) = 0;
+
+    // Bekleyen bir datagram varsa buf'a kopyalar ve boyutunu dondurur,
+    // yoksa hemen 0 dondurur.
+    virtual size_t receive(uint8_t *buf, size_t capacity, uint32_t *fromIp, uint16_t *fromPort) = 0;
+};
+
+class MonotonicClock {
+public:
+    virtual ~MonotonicClock() {}
+
+    // Acilistan beri gecen sure (mikrosaniye), geri gitmez.
+    virtual int64_t nowUs() = 0;
+};
+
+class SerialPort {
+public:
+    virtual ~SerialPort() {}
+
+    // Baytlari gonderim kuyruguna yazar, yazilan bayt sayisini dondurur
+    virtual size_t write(const uint8_t *data, size_t len) = 0;
+};
+
+// Darbe cikisi (PPS). Kenar anini cagiran secer; arka uc yukselen kenari
+// hemen baslatir ve genisligi kendisi (donanimda) uygular.
+class PulseOutput {
+public:
+    virtual ~PulseOutput() {}
+
+    virtual bool pulse(uint32_t widthUs) = 0;
+};
@@ -0,0 +1,108 @@
+#include "TimingStats.h"
+
+// Tolerans (+-2 ms) icinde ince, disinda kaba kovalar
+static const int32_t SEND_OFFSET_EDGES_US[] = {
+    -2000, -1000, -500, -200, -100, -50, -20, 0, 20, 50, 100, 200, 500, 1000, 2000
+};
+
+static const int32_t FRAME_TIME_EDGES_US[] = {
+    1, 2, 5, 10, 20, 50, 100, 200, 500, 1000
+};
+
+static const int32_t NTP_RTT_EDGES_US[] = {
+    250, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 250000
+};
+
+static const int32_t NTP_OFFSET_EDGES_US[] = {
+    -10000, -1000, -500, -100, -50, 0, 50, 100, 500, 1000, 10000
+};
+
+static int32_t clampI32(int64_t v) {
+    if (v > INT32_MAX) return INT32_MAX;
+    if (v < INT32_MIN) return INT32_MIN;
+    return (int32_t)v;
+}
+
+void SendStats::reset(int64_t nowLocalUs, uint32_t missedTotal, uint32_t duplicateTotal) {
+    offsetUs = Histogram(SEND_OFFSET_EDGES_US, HIST_EDGE_COUNT(SEND_OFFSET_EDGES_US));
+    txResidualUs = Histogram(SEND_OFFSET_EDGES_US, HIST_EDGE_COUNT(SEND_OFFSET_EDGES_US));
+    ppsOffsetUs = Histogram(SEND_OFFSET_EDGES_US, HIST_EDGE_COUNT(SEND_OFFSET_EDGES_US));
+    prepareUs = Histogram(FRAME_TIME_EDGES_US, HIST_EDGE_COUNT(FRAME_TIME_EDGES_US));
+    writeUs = Histogram(FRAME_TIME_EDGES_US, HIST_EDGE_COUNT(FRAME_TIME_EDGES_US));
+    sent = 0;
+    cacheMisses = 0;
+    txLeadUs = 0;
+    txOverheadUs = 0;
+    txTimeouts = 0;
+    ppsPulses = 0;
+    missed = 0;
+    duplicate = 0;
+    missedBase = missedTotal;
+    duplicateBase = duplicateTotal;
+    sinceLocalUs = nowLocalUs;
+}
+
+void SendStats::recordSend(int64_t deviationUs) {
+    offsetUs.add(clampI32(deviationUs));
+    sent++;
+}
+
+void SendStats::recordFrameTiming(uint32_t prepareTimeUs, uint32_t writeTimeUs, bool cacheHit) {
+    prepareUs.add(clampI32(prepareTimeUs));
+    writeUs.add(clampI32(writeTimeUs));
+    if (!cacheHit) {
+        cacheMisses++;
+    }
+}
+
+void SendStats::recordTxDone(int64_t residualUs, uint32_t leadUs, uint32_t overheadUs) {
+    txResidualUs.add(clampI32(residualUs));
+    txLeadUs = leadUs;
+    txOverheadUs = overheadUs;
+}
+
+void SendStats::recordPps(int64_t deviationUs) {
+    ppsOffsetUs.add(clampI32(deviationUs));
+    ppsPulses++;
+}
+
+void SendStats::updateCounters(uint32_t missedTotal, uint32_t duplicateTotal) {
+    missed = missedTotal - missedBase;
+    duplicate = duplicateTotal - duplicateBase;
+}
+
+void NtpStats::reset(int64_t nowLocalUs) {
+    for (uint8_t i = 0; i < STATS_NTP_SERVERS; i++) {
+        server[i].rttUs = Histogram(NTP_RTT_EDGES_US, HIST_EDGE_COUNT(NTP_RTT_EDGES_US));
+        server[i].offsetUs = Histogram(NTP_OFFSET_EDGES_US, HIST_EDGE_COUNT(NTP_OFFSET_EDGES_US));
+        server[i].replies = 0;
+        server[i].failures = 0;
+        server[i].falsetickers = 0;
+    }
+    sinceLocalUs = nowLocalUs;
+}
+
+void NtpStats::recordReply(uint8_t serverIndex, int64_t rttUs) {
+    if (serverIndex < STATS_NTP_SERVERS) {
+        server[serverIndex].rttUs.add(clampI32(rttUs));
+        server[serverIndex].replies++;
+    }
+}
+
+void NtpStats::recordOffset(uint8_t serverIndex, int64_t offsetUs) {
+    if (serverIndex < STATS_NTP_SERVERS) {
+        server[serverIndex].offsetUs.add(clampI32(offsetUs));
+    }
+}
+
+void NtpStats::recordFailure(uint8_t serverIndex) {
+    if (serverIndex < STATS_NTP_SERVERS) {
+        server[serverIndex].failures++;
+    }
+}
+
+void NtpStats::recordFalseticker(uint8_t serverIndex) {
+    if (serverIndex < STATS_NTP_SERVERS) {
+        server[serverIndex].falsetickers++;
+    }
+}
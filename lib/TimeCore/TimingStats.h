@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+#include "Histogram.h"
+#include "SntpEngine.h"
+
+//================================================================================
+// ZAMANLAMA ISTATISTIKLERI
+//================================================================================
+// Surekli acik, sabit bellekli olcumler. Her yapinin tek bir yazar gorevi
+// vardir (gonderim: cikis gorevi, NTP: ag gorevi); konsol SeqLock ile
+// yayinlanan kopyayi okur. Histogram kova sinirlari statik tablolardadir,
+// yapilar kopyalanabilir duz veridir.
+
+#define STATS_NTP_SERVERS SNTP_MAX_SERVERS
+
+struct SendStats {
+    Histogram offsetUs;         // Tahmini son durma biti - (saniye + TARGET_SEND_MS), us
+    Histogram txResidualUs;     // Olculen son durma biti (TX bitti) - hedef, us
+    Histogram ppsOffsetUs;      // PPS kenari - saniye basi, us
+    Histogram prepareUs;        // Kare hazirlama (takvim + bicim + checksum), pencere disinda
+    Histogram writeUs;          // Gonderim anindaki UART yazimi
+    uint32_t sent;
+    uint32_t cacheMisses;       // Hazir kare yoktu, pencere icinde hazirlandi
+    uint32_t txLeadUs;          // Son karede write()'in hedefe gore erken alinmasi
+    uint32_t txOverheadUs;      // Ogrenilen surucu payi (lead'in seri aktarim disi kismi)
+    uint32_t txTimeouts;        // TX bitti olayi gelmedi, olcum yok
+    uint32_t ppsPulses;
+    uint32_t missed;            // Sifirlamadan beri atlanan saniyeler
+    uint32_t duplicate;         // Sifirlamadan beri tekrarlanan saniyeler
+    uint32_t missedBase;        // Zamanlayicinin sifirlama anindaki toplamlari
+    uint32_t duplicateBase;
+    int64_t sinceLocalUs;       // Sifirlama ani (yerel monoton saat)
+
+    SendStats() { reset(0, 0, 0); }
+    void reset(int64_t nowLocalUs, uint32_t missedTotal, uint32_t duplicateTotal);
+    void recordSend(int64_t deviationUs);
+    void recordFrameTiming(uint32_t prepareTimeUs, uint32_t writeTimeUs, bool cacheHit);
+    void recordTxDone(int64_t residualUs, uint32_t leadUs, uint32_t overheadUs);
+    void recordTxTimeout() { txTimeouts++; }
+    void recordPps(int64_t deviationUs);
+    // SendScheduler'in kumulatif sayaclarini sifirlamaya gore isler
+    void updateCounters(uint32_t missedTotal, uint32_t duplicateTotal);
+};
+
+struct NtpServerStats {
+    Histogram rttUs;            // delta: ag gidis-donus gecikmesi
+    Histogram offsetUs;         // Olcum - disiplinli saat (saat hatasi)
+    uint32_t replies;
+    uint32_t failures;          // Zaman asimi / gonderim hatasi
+    uint32_t falsetickers;      // Secimde yanlis zaman verdigi turlar
+};
+
+struct NtpStats {
+    NtpServerStats server[STATS_NTP_SERVERS];
+    int64_t lastGoodSyncLocalUs;    // 0: hic basarili tur yok; reset() silmez
+    int64_t sinceLocalUs;
+
+    NtpStats() : lastGoodSyncLocalUs(0) { reset(0); }
+    void reset(int64_t nowLocalUs);
+    void recordReply(uint8_t serverIndex, int64_t rttUs);
+    // Disiplinli saat gecerliyken olcumun saate gore hatasi
+    void recordOffset(uint8_t serverIndex, int64_t offsetUs);
+    void recordFailure(uint8_t serverIndex);
+    void recordFalseticker(uint8_t serverIndex);
+    void markSynced(int64_t nowLocalUs) { lastGoodSyncLocalUs = nowLocalUs; }
+};
@@ -0,0 +1,26 @@
+#include "TxCompensation.h"
+
+void UartTxCompensator::setBaud(uint32_t baud) {
+    baud_ = baud > 0 ? baud : 1;
+    overheadScaled_ = 0;
+    samples_ = 0;
+}
+
+uint32_t UartTxCompensator::serializationUs(uint8_t length) const {
+    return (uint32_t)(((uint64_t)length * UART_BITS_PER_BYTE * 1000000 + baud_ - 1) / baud_);
+}
+
+bool UartTxCompensator::record(uint8_t length, uint32_t measuredUs) {
+    uint32_t serial = serializationUs(length);
+    uint32_t overhead = measuredUs > serial ? measuredUs - serial : 0;
+    if (overhead > TX_COMP_MAX_OVERHEAD_US) {
+        return false;
+    }
+    if (samples_ == 0) {
+        overheadScaled_ = overhead << TX_COMP_GAIN_SHIFT;
+    } else {
+        overheadScaled_ = overheadScaled_ - (overheadScaled_ >> TX_COMP_GAIN_SHIFT) + overhead;
+    }
+    samples_++;
+    return true;
+}
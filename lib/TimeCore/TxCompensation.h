@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+
+//================================================================================
+// UART GONDERIM GECIKMESI TELAFISI
+//================================================================================
+// write() cagrisi ile karenin son durma bitinin hattan cikmasi arasinda
+// iki gecikme vardir: seri aktarim (bayt sayisi x 10 bit / baud, 8N1) ve
+// surucu/FIFO payi. Ilki bicim ve baud'dan hesaplanir, ikincisi her karede
+// olculen write -> TX bitti suresinden ogrenilir (kayan ortalama, 1/2^k).
+// Gonderim bu toplam kadar erkene alinir; boylece son durma biti hedef
+// anina denk gelir.
+
+#define UART_BITS_PER_BYTE      10      // Baslangic + 8 veri + durma
+#define TX_COMP_GAIN_SHIFT      3       // Ortalama agirligi 1/8
+#define TX_COMP_MAX_OVERHEAD_US 2000    // Ustu ayni anda baska yazim: ornek atilir
+
+class UartTxCompensator {
+public:
+    explicit UartTxCompensator(uint32_t baud) { setBaud(baud); }
+
+    // Ogrenilen surucu payini da sifirlar
+    void setBaud(uint32_t baud);
+
+    uint32_t serializationUs(uint8_t length) const;
+    // write() cagrisindan son durma bitine beklenen sure
+    uint32_t leadUs(uint8_t length) const { return serializationUs(length) + overheadUs(); }
+
+    // Olculen write -> TX bitti suresi; false: ornek aykiri, atildi
+    bool record(uint8_t length, uint32_t measuredUs);
+
+    uint32_t overheadUs() const { return overheadScaled_ >> TX_COMP_GAIN_SHIFT; }
+    uint32_t samples() const { return samples_; }
+
+private:
+    uint32_t baud_;
+    uint32_t overheadScaled_;   // Surucu payi << TX_COMP_GAIN_SHIFT
+    uint32_t samples_;
+};
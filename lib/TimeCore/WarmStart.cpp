@@ -0,0 +1,45 @@
+#include "WarmStart.h"
+
+#include <stddef.h>
+
+static uint32_t crc32(const uint8_t *data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFUL;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t stateCrc(const WarmStartState &state) {
+    return crc32((const uint8_t *)&state, offsetof(WarmStartState, crc));
+}
+
+void warmStartSeal(WarmStartState &state) {
+    state.magic = WARM_START_MAGIC;
+    state.reserved[0] = 0;
+    state.reserved[1] = 0;
+    state.reserved[2] = 0;
+    state.crc = stateCrc(state);
+}
+
+bool warmStartValid(const WarmStartState &state) {
+    return state.magic == WARM_START_MAGIC && state.crc == stateCrc(state);
+}
+
+bool warmStartNvsDue(const WarmStartState &stored, const WarmStartState &current,
+                     uint32_t secondsSinceWrite) {
+    if (!warmStartValid(stored)) {
+        return true;
+    }
+    if (secondsSinceWrite < WARM_NVS_MIN_INTERVAL_S) {
+        return false;
+    }
+    int32_t delta = current.freqPpb - stored.freqPpb;
+    if (delta < 0) {
+        delta = -delta;
+    }
+    return delta >= WARM_NVS_FREQ_DELTA_PPB || current.lastServer != stored.lastServer;
+}
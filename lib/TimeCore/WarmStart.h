@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+
+//================================================================================
+// SICAK BASLANGIC (DISIPLIN DURUMU KAYDI)
+//================================================================================
+// Yakinsamis frekans duzeltmesi, son sistem sunucusu, sorgu ussu ve son faz
+// hatasi reset sonrasina tasinir. Birincil kopya RTC yavas bellegindedir
+// (yazilim/watchdog resetinde korunur, her basarili turda yazilir); guc
+// kesintisi icin NVS kopyasi yalnizca anlamli degisimde ve seyrek yazilir.
+// Kayit CRC-32 ile dogrulanir; bozuk ya da eski surum kayit yok sayilir.
+
+#define WARM_START_MAGIC                0x57535431UL    // "WST1"
+#define WARM_NVS_MIN_INTERVAL_S         21600           // NVS'ye en fazla 6 saatte bir
+#define WARM_NVS_FREQ_DELTA_PPB         100             // Bundan kucuk frekans degisimi yazilmaz
+
+struct WarmStartState {
+    uint32_t magic;
+    int32_t freqPpb;            // ClockDiscipline frekans duzeltmesi
+    int32_t lastOffsetUs;       // Son turdaki faz hatasi
+    uint32_t lastServer;        // Son sistem sunucusu (IPv4), 0: yok
+    uint8_t pollExp;            // Sorgu ussu (2^exp s)
+    uint8_t reserved[3];
+    uint32_t syncCount;         // Kaydin dayandigi basarili tur sayisi
+    uint32_t crc;
+};
+
+// Kaydi doldurur ve CRC'yi hesaplar
+void warmStartSeal(WarmStartState &state);
+bool warmStartValid(const WarmStartState &state);
+
+// Kalici (NVS) kopyanin yenilenmesi gerekiyor mu? stored gecersizse hemen,
+// degilse frekans ya da sunucu anlamli degistiyse ve asgari sure dolduysa.
+bool warmStartNvsDue(const WarmStartState &stored, const WarmStartState &current,
+                     uint32_t secondsSinceWrite);
@@ -0,0 +1,198 @@
+#include "EspTimeHal.h"
+
+#include <lwip/sockets.h>
+
+IPAddress toIPAddress(uint32_t ip) {
+    return IPAddress((uint8_t)(ip >> 24), (uint8_t)(ip >> 16), (uint8_t)(ip >> 8), (uint8_t)ip);
+}
+
+uint32_t fromIPAddress(const IPAddress &addr) {
+    return makeIPv4(addr[0], addr[1], addr[2], addr[3]);
+}
+
+bool WiFiUdpTransport::send(uint32_t ip, uint16_t port, const uint8_t *data, size_t len) {
+    if (!udp_.beginPacket(toIPAddress(ip), port)) {
+        return false;
+    }
+    udp_.write(data, len);
+    return udp_.endPacket() == 1;
+}
+
+size_t WiFiUdpTransport::receive(uint8_t *buf, size_t capacity, uint32_t *fromIp, uint16_t *fromPort) {
+    int size = udp_.parsePacket();
+    if (size <= 0) {
+        return 0;
+    }
+    *fromIp = fromIPAddress(udp_.remoteIP());
+    *fromPort = udp_.remotePort();
+    int n = udp_.read(buf, capacity);
+    udp_.flush();
+    return n > 0 ? (size_t)n : 0;
+}
+
+bool LwipUdpTransport::begin(uint16_t port) {
+    stop();
+    fd_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd_ < 0) {
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(fd_, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        stop();
+        return false;
+    }
+    return true;
+}
+
+void LwipUdpTransport::stop() {
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool LwipUdpTransport::send(uint32_t ip, uint16_t port, const uint8_t *data, size_t len) {
+    if (fd_ < 0) {
+        return false;
+    }
+    struct sockaddr_in to = {};
+    to.sin_family = AF_INET;
+    to.sin_port = htons(port);
+    to.sin_addr.s_addr = htonl(ip);
+    return sendto(fd_, data, len, MSG_DONTWAIT, (struct sockaddr *)&to, sizeof(to)) == (ssize_t)len;
+}
+
+size_t LwipUdpTransport::receive(uint8_t *buf, size_t capacity, uint32_t *fromIp, uint16_t *fromPort) {
+    if (fd_ < 0) {
+        return 0;
+    }
+    struct sockaddr_in from = {};
+    socklen_t fromLen = sizeof(from);
+    ssize_t n = recvfrom(fd_, buf, capacity, MSG_DONTWAIT, (struct sockaddr *)&from, &fromLen);
+    if (n <= 0) {
+        return 0;   // EWOULDBLOCK: bekleyen datagram yok
+    }
+    *fromIp = ntohl(from.sin_addr.s_addr);
+    *fromPort = ntohs(from.sin_port);
+    return (size_t)n;
+}
+
+// Hat bu kadar karakter suresi bosta kalinca RX zaman asimi olayi uretilir;
+// master komutlari aralikli geldiginden her komutun sonunda tek uyanis olur.
+#define UART_RX_IDLE_SYMBOLS   3
+
+bool IdfUartPort::begin(uint32_t baud, int rxPin, int txPin, size_t rxBufferSize, size_t txBufferSize,
+                        QueueSetHandle_t eventSet) {
+    uart_config_t config = {};
+    config.baud_rate = (int)baud;
+    config.data_bits = UART_DATA_8_BITS;
+    config.parity = UART_PARITY_DISABLE;
+    config.stop_bits = UART_STOP_BITS_1;
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    config.source_clk = UART_SCLK_APB;
+
+    if (uart_driver_install(port_, (int)rxBufferSize, (int)txBufferSize, IDF_UART_EVENT_QUEUE_LEN,
+                            &queue_, 0) != ESP_OK) {
+        queue_ = NULL;
+        return false;
+    }
+    if (eventSet != NULL && xQueueAddToSet(queue_, eventSet) != pdPASS) {
+        return false;
+    }
+    if (uart_param_config(port_, &config) != ESP_OK ||
+        uart_set_pin(port_, txPin, rxPin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) {
+        return false;
+    }
+    uart_set_rx_timeout(port_, UART_RX_IDLE_SYMBOLS);
+    return true;
+}
+
+size_t IdfUartPort::write(const uint8_t *data, size_t len) {
+    int n = uart_write_bytes(port_, (const char *)data, len);
+    return n > 0 ? (size_t)n : 0;
+}
+
+size_t IdfUartPort::print(const char *text) {
+    return write((const uint8_t *)text, strlen(text));
+}
+
+void IdfUartPort::flush() {
+    uart_wait_tx_done(port_, portMAX_DELAY);
+}
+
+bool IdfUartPort::waitTxDone(uint32_t timeoutMs) {
+    TickType_t ticks = pdMS_TO_TICKS(timeoutMs);
+    return uart_wait_tx_done(port_, ticks > 0 ? ticks : 1) == ESP_OK;
+}
+
+bool IdfUartPort::serviceEvent() {
+    uart_event_t event;
+    if (queue_ == NULL || xQueueReceive(queue_, &event, 0) != pdTRUE) {
+        return false;
+    }
+
+    switch (event.type) {
+        case UART_DATA:
+            counters_.wakeups++;
+            return true;
+        case UART_FIFO_OVF:
+            counters_.fifoOverflows++;
+            uart_flush_input(port_);
+            return false;
+        case UART_BUFFER_FULL:
+            counters_.bufferFull++;
+            uart_flush_input(port_);
+            return false;
+        case UART_FRAME_ERR:
+            counters_.framingErrors++;
+            return true;
+        case UART_PARITY_ERR:
+            counters_.parityErrors++;
+            return true;
+        case UART_BREAK:
+        case UART_DATA_BREAK:
+            counters_.breaks++;
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t IdfUartPort::read(uint8_t *buf, size_t capacity) {
+    int n = uart_read_bytes(port_, buf, capacity, 0);
+    if (n <= 0) {
+        return 0;
+    }
+    counters_.bytes += (uint32_t)n;
+    return (size_t)n;
+}
+
+bool RmtPulseOutput::begin(gpio_num_t pin) {
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX(pin, channel_);
+    config.clk_div = 80;    // 80 MHz APB -> 1 us
+    config.tx_config.idle_output_en = true;
+    config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+    if (rmt_config(&config) != ESP_OK || rmt_driver_install(channel_, 0, 0) != ESP_OK) {
+        return false;
+    }
+    ready_ = true;
+    return true;
+}
+
+bool RmtPulseOutput::pulse(uint32_t widthUs) {
+    if (!ready_) {
+        return false;
+    }
+    rmt_item32_t item;
+    item.level0 = 1;
+    item.duration0 = widthUs > RMT_PULSE_MAX_US ? RMT_PULSE_MAX_US : widthUs;
+    item.level1 = 0;
+    item.duration1 = 1;
+    return rmt_write_items(channel_, &item, 1, false) == ESP_OK;
+}
@@ -1,1097 +1,2750 @@
-#include <Arduino.h>
-#include <ETH.h>
-#include <NTPClient.h>
-#include <WiFiUDP.h>
-#include <HardwareSerial.h>
-#include <Preferences.h>
-#include <nvs_flash.h>
-#include "esp_system.h"
-#include "esp_task_wdt.h"
-
-//================================================================================
-// ETHERNET AYARLARI (WT32-ETH01)
-//================================================================================
-#define ETH_CLK_MODE    ETH_CLOCK_GPIO0_IN
-#define ETH_POWER_PIN   16
-#define ETH_TYPE        ETH_PHY_LAN8720
-#define ETH_ADDR        1
-#define ETH_MDC_PIN     23
-#define ETH_MDIO_PIN    18
-
-// Watchdog konfigürasyonu
-#define WDT_TIMEOUT_SECONDS 60
-#define WDT_RESET_INTERVAL 30000
-#define WDT_CRITICAL_OPERATIONS_TIMEOUT 10000
-
-// Watchdog durumu
-struct WatchdogManager {
-    unsigned long lastResetTime = 0;
-    bool isEnabled = false;
-    uint16_t resetCount = 0;
-    uint32_t lastRebootReason = 0;
-} wdtManager;
-
-//================================================================================
-// SERI HABERLEŞME (dsPIC'e tarih/saat gönderimi)
-//================================================================================
-HardwareSerial picSerial(2);
-#define PIC_RX_PIN 4
-#define PIC_TX_PIN 14
-#define PIC_BAUD_RATE 115200
-
-//================================================================================
-// UART İLETİŞİM (Birinci Kart ile - NTP bilgisi alımı)
-//================================================================================
-HardwareSerial masterSerial(1);
-#define MASTER_RX_PIN 36
-#define MASTER_TX_PIN 33
-#define MASTER_BAUD 115200
-
-// NTP komut buffer'ı
-char masterBuffer[32];
-uint8_t masterBufferIndex = 0;
-bool ntpConfigReceived = false;
-String receivedNtp1Part1 = "";
-String receivedNtp1Part2 = "";
-String receivedNtp2Part1 = "";
-String receivedNtp2Part2 = "";
-
-//================================================================================
-// NTP AYARLARI
-//================================================================================
-WiFiUDP ntpUDP;
-NTPClient timeClient(ntpUDP, "0.0.0.0", 10800); // Başlangıçta boş, UTC+3
-
-struct NTPServerManager {
-    String ntp1;                    // Master karttan gelen NTP1
-    String ntp2;                    // Master karttan gelen NTP2  
-    bool usingNtp2;                // Şu anda NTP2 mi kullanılıyor
-    uint8_t ntp1FailCount;         // NTP1 hata sayacı
-    uint8_t ntp2FailCount;         // NTP2 hata sayacı
-    bool hasValidConfig;           // Geçerli konfigürasyon var mı
-    unsigned long lastSyncTime;    // Son başarılı senkronizasyon zamanı
-    long timeOffset;               // Lokal saat düzeltme offseti (ms)
-} ntpManager;
-
-const uint8_t MAX_NTP_FAIL_COUNT = 5;      // Bir sunucudan diğerine geçmek için maksimum hata
-const unsigned long NTP_RETRY_INTERVAL = 10000;
-const unsigned long NTP_SYNC_INTERVAL = 10000;  // 10 saniyede bir senkronizasyon (çok daha sık)
-unsigned long lastNtpFailTime = 0;
-
-//================================================================================
-// KALICI HAFIZA (PREFERENCES)
-//================================================================================
-Preferences preferences;
-#define PREF_NTP_CONFIG_NAMESPACE "ntp-config"
-#define PREF_NTP_SERVER1_KEY "ntpServer1"
-#define PREF_NTP_SERVER2_KEY "ntpServer2"
-
-//================================================================================
-// GLOBAL DEĞİŞKENLER
-//================================================================================
-volatile bool ethConnected = false;
-char dateBuffer[8];
-char timeBuffer[8];
-
-// YENİ: HASSAS ZAMAN YÖNETİMİ EKLE
-struct PrecisionTimeManager {
-    unsigned long lastNtpEpoch;
-    unsigned long ntpCaptureMillis;
-    bool isInitialized;
-    int32_t clockDriftMs;
-    unsigned long driftCaptureTime;
-    uint32_t ntpRoundTripTime;
-} timeSync;
-
-#define TARGET_SEND_MS 50
-#define SEND_TOLERANCE 2
-
-//================================================================================
-// FONKSIYON PROTOTİPLERİ
-//================================================================================
-void WiFiEvent(WiFiEvent_t event);
-void initializeNTPServers();
-void saveNtpServers(String ntp1, String ntp2);
-void switchToNTP2();
-void switchToNTP1();
-uint8_t calculateChecksum(const char *str, uint8_t len);
-void sendStatusToPic(char status);
-void printNTPStatus();
-void printNetworkInfo();
-bool testDNSResolution();
-void handleSerialCommands();
-
-// Master kart iletişim fonksiyonları
-void listenForMasterCommands();
-void processMasterNTPCommand(const String& cmd);
-void applyReceivedNTPConfig();
-void testMasterConnection();
-String parseIPPart(const String& part);
-
-// Watchdog fonksiyonları
-void checkRebootReason();
-void initializeWatchdog();
-void feedWatchdog();
-void disableWatchdog();
-void saveWatchdogStats();
-void gracefulRestart();
-void loadWatchdogStats();
-void printWatchdogStatus();
-
-// Hassas senkronizasyon fonksiyonları
-unsigned long getPreciseEpochTime();
-uint16_t getPreciseMillisecond();
-bool updateTimeWithPrecision();
-void syncedSendDateToPic();
-void syncedSendTimeToPic();
-void handleSyncedDsPICCommunication();
-void setupPrecisionSync();
-void printSyncStatus();
-
-//================================================================================
-// WATCHDOG FONKSİYONLARI
-//================================================================================
-
-void checkRebootReason() {
-    esp_reset_reason_t reason = esp_reset_reason();
-    wdtManager.lastRebootReason = (uint32_t)reason;
-    
-    Serial.print("Son reboot nedeni: ");
-    switch (reason) {
-        case ESP_RST_POWERON:
-            Serial.println("Normal acilis");
-            break;
-        case ESP_RST_SW:
-            Serial.println("Yazilim restart");
-            break;
-        case ESP_RST_PANIC:
-            Serial.println("Sistem panic");
-            break;
-        case ESP_RST_INT_WDT:
-            Serial.println("Interrupt watchdog timeout");
-            break;
-        case ESP_RST_TASK_WDT:
-            Serial.println("Task watchdog timeout - SISTEM DONMUSTU!");
-            wdtManager.resetCount++;
-            break;
-        case ESP_RST_WDT:
-            Serial.println("Watchdog timeout");
-            wdtManager.resetCount++;
-            break;
-        case ESP_RST_BROWNOUT:
-            Serial.println("Voltaj dusugu");
-            break;
-        default:
-            Serial.printf("Bilinmeyen neden: %d\n", reason);
-            break;
-    }
-}
-
-void initializeWatchdog() {
-    esp_err_t result;
-    
-    result = esp_task_wdt_init(WDT_TIMEOUT_SECONDS, true);
-    
-    if (result == ESP_OK) {
-        result = esp_task_wdt_add(NULL);
-        
-        if (result == ESP_OK) {
-            wdtManager.isEnabled = true;
-            wdtManager.lastResetTime = millis();
-            Serial.printf("Watchdog Timer baslatildi (%d saniye timeout)\n", WDT_TIMEOUT_SECONDS);
-        } else {
-            Serial.printf("HATA: Task watchdog'a eklenemedi: %d\n", result);
-        }
-    } else {
-        Serial.printf("HATA: Watchdog baslatilamadi: %d\n", result);
-    }
-}
-
-void feedWatchdog() {
-    if (wdtManager.isEnabled) {
-        esp_task_wdt_reset();
-        wdtManager.lastResetTime = millis();
-        
-        static unsigned long lastDebugPrint = 0;
-        if (millis() - lastDebugPrint > 30000) {
-            lastDebugPrint = millis();
-            Serial.printf("[WDT] Watchdog resetlendi (Uptime: %lu sn)\n", millis() / 1000);
-        }
-    }
-}
-
-void disableWatchdog() {
-    if (wdtManager.isEnabled) {
-        esp_task_wdt_delete(NULL);
-        esp_task_wdt_deinit();
-        wdtManager.isEnabled = false;
-        Serial.println("Watchdog devre disi birakildi");
-    }
-}
-
-void saveWatchdogStats() {
-    preferences.begin("wdt-stats", false);
-    preferences.putUShort("resetCount", wdtManager.resetCount);
-    preferences.putULong("lastReboot", wdtManager.lastRebootReason);
-    preferences.putULong("uptime", millis());
-    preferences.end();
-    Serial.println("Watchdog istatistikleri kaydedildi");
-}
-
-void gracefulRestart() {
-    Serial.println("Guvenli sistem restart baslatiliyor...");
-    
-    disableWatchdog();
-    timeClient.end();
-    saveWatchdogStats();
-    picSerial.flush();
-    masterSerial.flush();
-    Serial.flush();
-    
-    Serial.println("3 saniye sonra restart...");
-    delay(3000);
-    ESP.restart();
-}
-
-void loadWatchdogStats() {
-    preferences.begin("wdt-stats", true);
-    wdtManager.resetCount = preferences.getUShort("resetCount", 0);
-    uint32_t lastReboot = preferences.getULong("lastReboot", 0);
-    uint32_t lastUptime = preferences.getULong("uptime", 0);
-    preferences.end();
-    
-    if (wdtManager.resetCount > 0) {
-        Serial.printf("Onceki watchdog reset sayisi: %d\n", wdtManager.resetCount);
-        Serial.printf("Onceki uptime: %lu saniye\n", lastUptime / 1000);
-    }
-}
-
-void printWatchdogStatus() {
-    Serial.println("\n=== WATCHDOG DURUM ===");
-    Serial.printf("Durum: %s\n", wdtManager.isEnabled ? "AKTIF" : "PASIF");
-    Serial.printf("Timeout: %d saniye\n", WDT_TIMEOUT_SECONDS);
-    Serial.printf("Son Reset: %lu ms once\n", millis() - wdtManager.lastResetTime);
-    Serial.printf("Reset Sayisi: %d\n", wdtManager.resetCount);
-    Serial.printf("Uptime: %lu saniye\n", millis() / 1000);
-    Serial.println("=====================\n");
-}
-
-//================================================================================
-// HASSAS ZAMAN SENKRONIZASYONU FONKSİYONLARI
-//================================================================================
-
-unsigned long getPreciseEpochTime() {
-    if (!timeSync.isInitialized) {
-        return timeClient.getEpochTime();
-    }
-    unsigned long elapsedMillis = millis() - timeSync.ntpCaptureMillis;
-    return timeSync.lastNtpEpoch + (elapsedMillis / 1000);
-}
-
-uint16_t getPreciseMillisecond() {
-    if (!timeSync.isInitialized) {
-        return millis() % 1000;
-    }
-    unsigned long elapsedMillis = millis() - timeSync.ntpCaptureMillis;
-    return elapsedMillis % 1000;
-}
-
-bool updateTimeWithPrecision() {
-    if (!ntpManager.hasValidConfig) {
-        Serial.println("[NTP] Hata: Gecerli konfigurasyon yok");
-        return false;
-    }
-
-    if (!ethConnected) {
-        Serial.println("[NTP] Hata: Ethernet baglantisi yok");
-        return false;
-    }
-
-    // Çoklu NTP örnekleme - en düşük RTT'yi seç
-    unsigned long bestRTT = 999999;
-    unsigned long bestEpoch = 0;
-    unsigned long bestCaptureMillis = 0;
-
-    for (int sample = 0; sample < 3; sample++) {
-        unsigned long beforeMillis = millis();
-
-        if (timeClient.forceUpdate()) {
-            unsigned long afterMillis = millis();
-            unsigned long roundTripTime = afterMillis - beforeMillis;
-
-            if (roundTripTime < bestRTT) {
-                bestRTT = roundTripTime;
-                bestEpoch = timeClient.getEpochTime();
-                bestCaptureMillis = beforeMillis + (roundTripTime / 2);
-            }
-        }
-
-        if (sample < 2) delay(100);
-    }
-
-    if (bestEpoch > 0) {
-        // Drift hesaplama (eğer önceki veri varsa)
-        if (timeSync.isInitialized) {
-            unsigned long localElapsed = millis() - timeSync.ntpCaptureMillis;
-            unsigned long expectedEpoch = timeSync.lastNtpEpoch + (localElapsed / 1000);
-            int32_t drift = (int32_t)(bestEpoch - expectedEpoch) * 1000;
-
-            // Drift'i güncelle (EWMA - üstel ağırlıklı ortalama)
-            timeSync.clockDriftMs = (timeSync.clockDriftMs * 7 + drift) / 8;
-
-            Serial.printf("[NTP] Drift: %ld ms\n", drift);
-        }
-
-        timeSync.lastNtpEpoch = bestEpoch;
-        timeSync.ntpCaptureMillis = bestCaptureMillis;
-        timeSync.ntpRoundTripTime = bestRTT;
-        timeSync.isInitialized = true;
-        timeSync.driftCaptureTime = millis();
-        ntpManager.lastSyncTime = millis();
-
-        Serial.printf("[NTP] Sync OK | RTT: %lums | Epoch: %lu | ClockDrift: %ldms\n",
-                      bestRTT, bestEpoch, timeSync.clockDriftMs);
-        return true;
-    } else {
-        Serial.println("[NTP] Hata: Tum orneklemeler basarisiz");
-        return false;
-    }
-}
-
-void syncedSendDateToPic() {
-    time_t epochTime = getPreciseEpochTime();
-    struct tm *timeinfo = localtime(&epochTime);
-    
-    snprintf(dateBuffer, 7, "%02u%02u%02u", 
-             timeinfo->tm_mday, 
-             timeinfo->tm_mon + 1, 
-             timeinfo->tm_year % 100);
-    
-    uint8_t checksum = calculateChecksum(dateBuffer, 6);
-    dateBuffer[6] = 'A' + checksum;
-    dateBuffer[7] = '\0';
-    
-    picSerial.write((uint8_t*)dateBuffer, 7);
-    
-    uint16_t actualMs = getPreciseMillisecond();
-    Serial.printf("[→dsPIC] Tarih: %s | Ms: %u\n", dateBuffer, actualMs);
-}
-
-void syncedSendTimeToPic() {
-    snprintf(timeBuffer, 7, "%02u%02u%02u", 
-             timeClient.getHours(), 
-             timeClient.getMinutes(), 
-             timeClient.getSeconds());
-    
-    uint8_t checksum = calculateChecksum(timeBuffer, 6);
-    timeBuffer[6] = 'a' + checksum;
-    timeBuffer[7] = '\0';
-    
-    picSerial.write((uint8_t*)timeBuffer, 7);
-    
-    uint16_t actualMs = getPreciseMillisecond();
-    Serial.printf("[→dsPIC] Saat: %s | Ms: %u\n", timeBuffer, actualMs);
-}
-
-void handleSyncedDsPICCommunication() {
-    static unsigned long lastSendEpoch = 0;
-    static bool nextIsTarih = true;
-    
-    unsigned long currentEpoch = getPreciseEpochTime();
-    uint16_t currentMs = getPreciseMillisecond();
-    
-    if (currentMs >= (TARGET_SEND_MS - SEND_TOLERANCE) && 
-        currentMs <= (TARGET_SEND_MS + SEND_TOLERANCE)) {
-        
-        if (currentEpoch != lastSendEpoch) {
-            lastSendEpoch = currentEpoch;
-            
-            if (nextIsTarih) {
-                syncedSendDateToPic();
-            } else {
-                syncedSendTimeToPic();
-            }
-            
-            nextIsTarih = !nextIsTarih;
-            
-            Serial.printf("[SYNC] Hedef: %dms | Gercek: %ums | Sapma: %dms\n", 
-                          TARGET_SEND_MS, currentMs, 
-                          (int)currentMs - (int)TARGET_SEND_MS);
-        }
-    }
-}
-
-void setupPrecisionSync() {
-    timeSync.lastNtpEpoch = 0;
-    timeSync.ntpCaptureMillis = 0;
-    timeSync.isInitialized = false;
-    timeSync.clockDriftMs = 0;
-    timeSync.driftCaptureTime = 0;
-    timeSync.ntpRoundTripTime = 0;
-
-    Serial.println("\n=== HASSAS SENKRONIZASYON SISTEMI ===");
-    Serial.printf("Hedef gonderim zamani: %dms\n", TARGET_SEND_MS);
-    Serial.printf("Tolerans: ±%dms\n", SEND_TOLERANCE);
-    Serial.println("=====================================\n");
-
-    if (ethConnected && ntpManager.hasValidConfig) {
-        Serial.println("Ilk hassas NTP senkronizasyonu yapiliyor...");
-
-        for (int attempt = 0; attempt < 5; attempt++) {
-            if (updateTimeWithPrecision()) {
-                Serial.println("Hassas senkronizasyon basarili!");
-                break;
-            }
-            Serial.printf("Deneme %d basarisiz...\n", attempt + 1);
-            delay(1000);
-            feedWatchdog();
-        }
-    }
-}
-
-void printSyncStatus() {
-    Serial.println("\n=== SENKRONIZASYON DURUMU ===");
-    Serial.printf("Hassas zaman: %s\n", timeSync.isInitialized ? "AKTIF" : "PASIF");
-    Serial.printf("Epoch: %lu\n", getPreciseEpochTime());
-    Serial.printf("Milisaniye: %u / 1000\n", getPreciseMillisecond());
-    Serial.printf("Hedef gonderim: %dms (±%dms)\n", TARGET_SEND_MS, SEND_TOLERANCE);
-    Serial.printf("Son NTP: %lu ms once\n", millis() - ntpManager.lastSyncTime);
-    Serial.printf("Son RTT: %lu ms\n", timeSync.ntpRoundTripTime);
-    Serial.printf("Clock Drift: %ld ms\n", timeSync.clockDriftMs);
-    Serial.println("============================\n");
-}
-
-//================================================================================
-// NTP FONKSİYONLARI
-//================================================================================
-
-void initializeNTPServers() {
-    ntpManager.usingNtp2 = false;
-    ntpManager.ntp1FailCount = 0;
-    ntpManager.ntp2FailCount = 0;
-    ntpManager.hasValidConfig = false;
-    ntpManager.lastSyncTime = 0;
-    ntpManager.timeOffset = 0;
-
-    // Master karttan gelen kayıtlı sunucuları yükle
-    preferences.begin(PREF_NTP_CONFIG_NAMESPACE, true);
-    String savedNtp1 = preferences.getString(PREF_NTP_SERVER1_KEY, "");
-    String savedNtp2 = preferences.getString(PREF_NTP_SERVER2_KEY, "");
-    preferences.end();
-    
-    if (savedNtp1 != "" && savedNtp1.length() > 6) {
-        ntpManager.ntp1 = savedNtp1;
-        ntpManager.ntp2 = savedNtp2;  // Boş olabilir
-        ntpManager.hasValidConfig = true;
-        
-        Serial.println("=== KAYITLI NTP KONFIGURASYONU YUKLENDI ===");
-        Serial.print("NTP1: "); Serial.println(ntpManager.ntp1);
-        Serial.print("NTP2: "); 
-        Serial.println(ntpManager.ntp2.length() > 0 ? ntpManager.ntp2 : "Yok");
-        Serial.println("==========================================");
-    } else {
-        Serial.println("!!! Kayitli NTP konfigurasyonu yok !!!");
-        Serial.println("Master karttan konfigürasyon bekleniyor...");
-    }
-}
-
-void saveNtpServers(String ntp1, String ntp2) {
-    preferences.begin(PREF_NTP_CONFIG_NAMESPACE, false);
-    preferences.putString(PREF_NTP_SERVER1_KEY, ntp1);
-    preferences.putString(PREF_NTP_SERVER2_KEY, ntp2);
-    preferences.end();
-    Serial.println("Master NTP sunuculari kalici olarak kaydedildi.");
-}
-
-void switchToNTP2() {
-    if (ntpManager.ntp2.length() > 6) {
-        ntpManager.usingNtp2 = true;
-        ntpManager.ntp2FailCount = 0;
-        timeClient.setPoolServerName(ntpManager.ntp2.c_str());
-        
-        Serial.println("!!! NTP2'ye gecildi !!!");
-        Serial.print("Yeni sunucu: ");
-        Serial.println(ntpManager.ntp2);
-    } else {
-        Serial.println("UYARI: NTP2 adresi tanimli degil!");
-        // NTP1'i tekrar dene
-        ntpManager.ntp1FailCount = 0;
-    }
-}
-
-void switchToNTP1() {
-    if (ntpManager.ntp1.length() > 6) {
-        ntpManager.usingNtp2 = false;
-        ntpManager.ntp1FailCount = 0;
-        timeClient.setPoolServerName(ntpManager.ntp1.c_str());
-        
-        Serial.println("!!! NTP1'e geri donuldu !!!");
-        Serial.print("Yeni sunucu: ");
-        Serial.println(ntpManager.ntp1);
-    }
-}
-
-uint8_t calculateChecksum(const char *str, uint8_t len) {
-    uint8_t sum = 0;
-    for (uint8_t i = 0; i < len; i++) {
-        sum += (str[i] - '0');
-    }
-    return sum % 10;
-}
-
-
-void sendStatusToPic(char status) {
-    picSerial.write(status);
-    if (status == 'Y') {
-        Serial.println("dsPIC'e durum: Y (Ethernet yok)");
-    } else if (status == 'X') {
-        Serial.println("dsPIC'e durum: X (NTP yok)");
-    }
-}
-
-void printNTPStatus() {
-    Serial.println("\n=== NTP DURUM ===");
-    
-    if (!ntpManager.hasValidConfig) {
-        Serial.println("DURUM: KONFIGURASYON YOK!");
-        Serial.println("Master karttan NTP bilgisi bekleniyor...");
-    } else {
-        Serial.print("NTP1: "); 
-        Serial.print(ntpManager.ntp1);
-        Serial.print(" (Hata: ");
-        Serial.print(ntpManager.ntp1FailCount);
-        Serial.println(")");
-        
-        Serial.print("NTP2: ");
-        if (ntpManager.ntp2.length() > 6) {
-            Serial.print(ntpManager.ntp2);
-            Serial.print(" (Hata: ");
-            Serial.print(ntpManager.ntp2FailCount);
-            Serial.println(")");
-        } else {
-            Serial.println("Tanimli degil");
-        }
-        
-        Serial.print("AKTIF SUNUCU: ");
-        if (ntpManager.usingNtp2) {
-            Serial.print("NTP2 - ");
-            Serial.println(ntpManager.ntp2);
-        } else {
-            Serial.print("NTP1 - ");
-            Serial.println(ntpManager.ntp1);
-        }
-    }
-    Serial.println("=================\n");
-}
-
-//================================================================================
-// MASTER KART İLETİŞİM FONKSİYONLARI
-//================================================================================
-
-String parseIPPart(const String& part) {
-    if (part.length() != 6) return "";
-    
-    String octet1 = part.substring(0, 3);
-    String octet2 = part.substring(3, 6);
-    
-    int o1 = octet1.toInt();
-    int o2 = octet2.toInt();
-    
-    return String(o1) + "." + String(o2);
-}
-
-void listenForMasterCommands() {
-    while (masterSerial.available() > 0) {
-        char receivedChar = masterSerial.read();
-        
-        if (receivedChar == 'u' || receivedChar == 'y' || 
-            receivedChar == 'w' || receivedChar == 'x') {
-            
-            masterBuffer[masterBufferIndex] = '\0';
-            String command = String(masterBuffer) + receivedChar;
-            
-            Serial.print("Master karttan komut: ");
-            Serial.println(command);
-            
-            processMasterNTPCommand(command);
-            
-            masterBufferIndex = 0;
-            memset(masterBuffer, 0, sizeof(masterBuffer));
-            
-        } else if ((receivedChar >= '0' && receivedChar <= '9') && 
-                   masterBufferIndex < sizeof(masterBuffer) - 1) {
-            masterBuffer[masterBufferIndex++] = receivedChar;
-        }
-    }
-}
-
-void processMasterNTPCommand(const String& cmd) {
-    if (cmd.endsWith("u")) {
-        receivedNtp1Part1 = cmd.substring(0, 6);
-        Serial.print("NTP1 Part1 alindi: ");
-        Serial.println(receivedNtp1Part1);
-        masterSerial.println("ACK");
-        masterSerial.flush();
-        
-    } else if (cmd.endsWith("y")) {
-        receivedNtp1Part2 = cmd.substring(0, 6);
-        Serial.print("NTP1 Part2 alindi: ");
-        Serial.println(receivedNtp1Part2);
-        
-        if (receivedNtp1Part1.length() == 6 && receivedNtp1Part2.length() == 6) {
-            String ntp1 = parseIPPart(receivedNtp1Part1) + "." + parseIPPart(receivedNtp1Part2);
-            Serial.print("NTP1 IP adresi: ");
-            Serial.println(ntp1);
-            masterSerial.println("ACK");
-            masterSerial.flush();
-        }
-        
-    } else if (cmd.endsWith("w")) {
-        receivedNtp2Part1 = cmd.substring(0, 6);
-        Serial.print("NTP2 Part1 alindi: ");
-        Serial.println(receivedNtp2Part1);
-        masterSerial.println("ACK");
-        masterSerial.flush();
-        
-    } else if (cmd.endsWith("x")) {
-        receivedNtp2Part2 = cmd.substring(0, 6);
-        Serial.print("NTP2 Part2 alindi: ");
-        Serial.println(receivedNtp2Part2);
-        
-        if (receivedNtp2Part1.length() == 6 && receivedNtp2Part2.length() == 6) {
-            String ntp2 = parseIPPart(receivedNtp2Part1) + "." + parseIPPart(receivedNtp2Part2);
-            Serial.print("NTP2 IP adresi: ");
-            Serial.println(ntp2);
-            masterSerial.println("ACK");
-            masterSerial.flush();
-            
-            applyReceivedNTPConfig();
-        }
-    }
-}
-
-void applyReceivedNTPConfig() {
-    String ntp1 = parseIPPart(receivedNtp1Part1) + "." + parseIPPart(receivedNtp1Part2);
-    String ntp2 = "";
-    
-    if (receivedNtp2Part1.length() == 6 && receivedNtp2Part2.length() == 6) {
-        ntp2 = parseIPPart(receivedNtp2Part1) + "." + parseIPPart(receivedNtp2Part2);
-    }
-    
-    Serial.println("\n=== MASTER KARTTAN NTP KONFIGURASYON ===");
-    Serial.print("NTP1: "); Serial.println(ntp1);
-    Serial.print("NTP2: "); Serial.println(ntp2.length() > 0 ? ntp2 : "Yok");
-    
-    if (ntp1.length() > 7) {
-        ntpManager.ntp1 = ntp1;
-        ntpManager.ntp2 = ntp2;
-        ntpManager.hasValidConfig = true;
-        ntpManager.usingNtp2 = false;
-        ntpManager.ntp1FailCount = 0;
-        ntpManager.ntp2FailCount = 0;
-        
-        saveNtpServers(ntp1, ntp2);
-
-        // DÜZELTİLMİŞ KISIM: setPoolServerName kullan
-        timeClient.setPoolServerName(ntp1.c_str());
-        timeClient.setUpdateInterval(10000);  // 10 saniye
-        
-        // Eğer daha önce başlatılmamışsa başlat
-        if (!ntpConfigReceived) {
-            timeClient.begin();
-            Serial.println("NTP istemcisi ilk kez baslatildi");
-        }
-        
-        ntpConfigReceived = true;
-        
-        // Hassas senkronizasyonu başlat
-        setupPrecisionSync();
-        
-        // Bufferları temizle
-        receivedNtp1Part1 = "";
-        receivedNtp1Part2 = "";
-        receivedNtp2Part1 = "";
-        receivedNtp2Part2 = "";
-        
-        Serial.println("Yeni NTP konfigürasyonu uygulandi ve hassas senkronizasyon baslatildi");
-    }
-}
-
-
-void testMasterConnection() {
-    Serial.println("Master kart baglantisi test ediliyor...");
-    masterSerial.println("TEST");
-    
-    unsigned long startTime = millis();
-    String response = "";
-    
-    while (millis() - startTime < 1000) {
-        if (masterSerial.available()) {
-            char c = masterSerial.read();
-            if (c == '\n' || c == '\r') {
-                if (response.length() > 0) {
-                    Serial.print("Master kart yaniti: ");
-                    Serial.println(response);
-                    return;
-                }
-            } else {
-                response += c;
-            }
-        }
-        delay(1);
-    }
-    
-    Serial.println("Master karttan yanit alinamadi");
-}
-
-//================================================================================
-// NETWORK FONKSİYONLARI
-//================================================================================
-
-void printNetworkInfo() {
-    Serial.println("\n=== AG BILGILERI ===");
-    Serial.print("IP Adresi: "); Serial.println(ETH.localIP());
-    Serial.print("Gateway: "); Serial.println(ETH.gatewayIP());
-    Serial.print("Subnet Mask: "); Serial.println(ETH.subnetMask());
-    Serial.print("DNS: "); Serial.println(ETH.dnsIP());
-    Serial.print("MAC Adresi: "); Serial.println(ETH.macAddress());
-    Serial.print("Link Durumu: "); Serial.println(ETH.linkUp() ? "Bagli" : "Bagli Degil");
-    Serial.print("Hiz: "); Serial.print(ETH.linkSpeed()); Serial.println(" Mbps");
-    Serial.print("Full Duplex: "); Serial.println(ETH.fullDuplex() ? "Evet" : "Hayir");
-    Serial.println("==================\n");
-}
-
-bool testDNSResolution() {
-    Serial.println("DNS cozumleme testi yapiliyor...");
-    
-    IPAddress testIP;
-    bool dnsWorking = WiFi.hostByName("google.com", testIP);
-    
-    if (dnsWorking) {
-        Serial.print("DNS calisyor - google.com: ");
-        Serial.println(testIP);
-        return true;
-    } else {
-        Serial.println("DNS sorunu tespit edildi!");
-        return false;
-    }
-}
-
-void handleSerialCommands() {
-    if (Serial.available()) {
-        String command = Serial.readStringUntil('\n');
-        command.trim();
-        
-        if (command.length() > 50) {
-            Serial.println("HATA: Komut cok uzun!");
-            return;
-        }
-        
-        if (command == "status") {
-            printNTPStatus();
-            printNetworkInfo();
-            printWatchdogStatus();
-            
-        } else if (command == "reset") {
-            gracefulRestart();
-            
-        } else if (command == "wdt") {
-            printWatchdogStatus();
-            
-        } else if (command == "testmaster") {
-            testMasterConnection();
-    
-        } else if (command == "masterinfo") {
-            Serial.println("\n=== MASTER KART DURUMU ===");
-            Serial.println("Baglanti: IO36(RX) <-> IO33(TX)");
-            Serial.print("Baudrate: "); Serial.println(MASTER_BAUD);
-            Serial.print("NTP konfig alindi: "); 
-            Serial.println(ntpConfigReceived ? "EVET" : "HAYIR");
-            if (receivedNtp1Part1.length() > 0) {
-                Serial.print("NTP1 Part1: "); Serial.println(receivedNtp1Part1);
-            }
-            if (receivedNtp1Part2.length() > 0) {
-                Serial.print("NTP1 Part2: "); Serial.println(receivedNtp1Part2);
-            }
-            Serial.println("========================\n");
-            
-            } else if (command == "sync") {
-            printSyncStatus();
-            
-        } else if (command == "testsync") {
-            Serial.println("10 saniye senkronizasyon testi...");
-            for (int i = 0; i < 10; i++) {
-                Serial.printf("T+%ds: Epoch=%lu, Ms=%u\n",
-                              i, getPreciseEpochTime(), getPreciseMillisecond());
-                delay(1000);
-            }
-
-        } else if (command == "forcesync") {
-            Serial.println("Zorla NTP senkronizasyonu baslatiliyor...");
-            if (updateTimeWithPrecision()) {
-                Serial.println("Senkronizasyon basarili!");
-                printSyncStatus();
-            } else {
-                Serial.println("Senkronizasyon BASARISIZ!");
-            }
-
-        } else if (command == "help") {
-            Serial.println("\n=== KOMUTLAR ===");
-            Serial.println("status     - Sistem durumu");
-            Serial.println("reset      - Guvenli restart");
-            Serial.println("wdt        - Watchdog durumu");
-            Serial.println("testmaster - Master kart baglantisi test");
-            Serial.println("masterinfo - Master kart bilgileri");
-            Serial.println("sync       - Senkronizasyon durumu");
-            Serial.println("testsync   - 10 saniye senkronizasyon testi");
-            Serial.println("forcesync  - Zorla NTP senkronizasyonu");
-            Serial.println("help       - Bu yardim");
-            Serial.println("\n=== PROTOKOL ===");
-            Serial.println("Master kart: 192168u, 001002y, 192169w, 001001x");
-            Serial.println("dsPIC'e: Tarih/Saat gonderimi");
-            Serial.println("================\n");
-        }
-    }
-}
-
-void WiFiEvent(WiFiEvent_t event) {
-    switch (event) {
-        case ARDUINO_EVENT_ETH_START:
-            Serial.println("ETH Baslatildi");
-            ETH.setHostname("wt32-eth01-slave");
-            break;
-        case ARDUINO_EVENT_ETH_CONNECTED:
-            Serial.println("ETH Baglandi");
-            break;
-        case ARDUINO_EVENT_ETH_GOT_IP:
-            Serial.println("\n--- DHCP Bilgileri ---");
-            Serial.print("  IP Adresi: "); Serial.println(ETH.localIP());
-            Serial.print("  Ag Gecidi: "); Serial.println(ETH.gatewayIP());
-            Serial.print("  DNS: "); Serial.println(ETH.dnsIP());
-            Serial.println("----------------------");
-            ethConnected = true;
-            break;
-        case ARDUINO_EVENT_ETH_DISCONNECTED:
-            Serial.println("ETH Baglanti Kesildi");
-            ethConnected = false;
-            break;
-        case ARDUINO_EVENT_ETH_STOP:
-            Serial.println("ETH Durduruldu");
-            ethConnected = false;
-            break;
-        default:
-            break;
-    }
-}
-
-//================================================================================
-// KURULUM (SETUP)
-//================================================================================
-void setup() {
-    Serial.begin(115200);
-    
-    checkRebootReason();
-    initializeWatchdog();
-    
-    Serial.println("WT32-ETH01 NTP Slave Kart baslatiliyor...");
-    Serial.println("NTP bilgisi Master karttan alinacak");
-
-    esp_err_t ret = nvs_flash_init();
-    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
-        Serial.println("NVS flash temizleniyor...");
-        ESP_ERROR_CHECK(nvs_flash_erase());
-        ret = nvs_flash_init();
-    }
-    if (ret == ESP_OK) {
-        Serial.println("NVS flash baslatildi.");
-    }
-    
-    feedWatchdog();
-
-    // Master kart ile iletişim başlat
-    masterSerial.begin(MASTER_BAUD, SERIAL_8N1, MASTER_RX_PIN, MASTER_TX_PIN);
-    Serial.println("Master kart iletisimi baslatildi (IO36-RX / IO33-TX)");
-    Serial.printf("Baudrate: %d\n", MASTER_BAUD);
-
-    // dsPIC'e tarih/saat göndermek için serial başlat
-    picSerial.begin(PIC_BAUD_RATE, SERIAL_8N1, PIC_RX_PIN, PIC_TX_PIN);
-    Serial.println("dsPIC iletisimi baslatildi (IO4-RX / IO14-TX)");
-
-    WiFi.onEvent(WiFiEvent);
-    ETH.begin(ETH_ADDR, ETH_POWER_PIN, ETH_MDC_PIN, ETH_MDIO_PIN, ETH_TYPE, ETH_CLK_MODE);
-
-    feedWatchdog();
-
-    Serial.print("Ethernet baglantisi bekleniyor...");
-    unsigned long startTime = millis();
-    while (!ethConnected && (millis() - startTime) < 30000) {
-        delay(500);
-        Serial.print(".");
-        
-        if ((millis() - wdtManager.lastResetTime) > 5000) {
-            feedWatchdog();
-        }
-    }
-    Serial.println();
-
-    if (!ethConnected) {
-        Serial.println("HATA: Ethernet baglantisi 30 saniyede kurulamadi!");
-        return;
-    }
-
-    Serial.println("DNS sunuculari manuel olarak ayarlaniyor...");
-    ETH.config(ETH.localIP(), ETH.gatewayIP(), ETH.subnetMask(), 
-               IPAddress(8, 8, 8, 8), IPAddress(8, 8, 4, 4));
-    
-    delay(2000);
-    feedWatchdog();
-    
-    printNetworkInfo();
-
-    if (testDNSResolution()) {
-        Serial.println("DNS cozumleme basarili");
-    } else {
-        Serial.println("DNS sorunu - IP adresleri kullanilacak");
-    }
-    
-    feedWatchdog();
-    
-    // NTP sunucularını başlat
-    initializeNTPServers();
-    
-    // Eğer kayıtlı konfigürasyon varsa NTP'yi başlat
-    if (ntpManager.hasValidConfig) {
-        String currentServer = ntpManager.usingNtp2 ? ntpManager.ntp2 : ntpManager.ntp1;
-        timeClient.setPoolServerName(currentServer.c_str());
-        
-        // KRITIK: Çok sık güncelleme için interval'i düşür (10 saniye)
-        timeClient.setUpdateInterval(10000);  // 10 saniye
-
-        // NTP başlatmadan önce UDP socket'i optimize et
-        ntpUDP.begin(123);  // NTP portu
-
-        timeClient.begin();
-
-        Serial.println("NTP istemcisi baslaniyor...");
-        Serial.print("Baslangic NTP sunucusu: ");
-        Serial.println(currentServer);
-        Serial.print("Guncelleme araligi: 10 saniye\n");
-        
-        feedWatchdog();
-        
-        // İlk senkronizasyonda forceUpdate kullan
-        Serial.println("Ilk NTP senkronizasyonu (forceUpdate) deneniyor...");
-        bool syncSuccess = false;
-        for (int attempt = 0; attempt < 5; attempt++) {
-            // forceUpdate() kullanarak anında senkronize ol
-            if (timeClient.forceUpdate()) {
-                ntpManager.lastSyncTime = millis();
-                Serial.printf("NTP senkronizasyonu basarili! (Deneme %d)\n", attempt + 1);
-                Serial.printf("Epoch Time: %lu\n", timeClient.getEpochTime());
-                syncSuccess = true;
-                break;
-            }
-            Serial.printf("Deneme %d basarisiz, tekrar deneniyor...\n", attempt + 1);
-            delay(1000);  // Denemeler arası kısa bekleme
-            feedWatchdog();
-        }
-
-        if (syncSuccess) {
-        setupPrecisionSync();
-        }
-
-        if (!syncSuccess) {
-            Serial.println("UYARI: Ilk senkronizasyon basarisiz!");
-        }
-    } else {
-        Serial.println("!!! UYARI: Master karttan NTP konfigurasyonu bekleniyor !!!");
-        Serial.println("NTP istemcisi henuz baslatilmadi.");
-    }
-    
-    printNTPStatus();
-    printWatchdogStatus();
-
-    // BURAYA YENİ SATIR EKLE:
-    setupPrecisionSync();
-    
-    // Master kart bağlantısını test et
-    testMasterConnection();
-    
-    Serial.println("\n=== SISTEM HAZIR ===");
-    Serial.println("Master karttan NTP bilgisi bekleniyor...");
-    Serial.println("Komutlar: 'status', 'reset', 'testmaster', 'masterinfo', 'help'");
-}
-
-//================================================================================
-// ANA DÖNGÜ (LOOP)
-//================================================================================
-void loop() {
-    feedWatchdog();
-    listenForMasterCommands();
-    handleSerialCommands();
-
-    static unsigned long lastNtpUpdate = 0;
-    static unsigned long lastNetworkCheck = 0;
-
-    // Ağ durumu kontrol
-    if (millis() - lastNetworkCheck >= 30000) {
-        lastNetworkCheck = millis();
-        
-        bool linkStatus = ETH.linkUp();
-        IPAddress currentIP = ETH.localIP();
-        
-        if (!linkStatus || currentIP.toString() == "0.0.0.0") {
-            if (ethConnected) {
-                Serial.println("Ethernet baglantisi kesildi!");
-                ethConnected = false;
-            }
-        } else if (!ethConnected) {
-            Serial.println("Ethernet yeniden kuruldu!");
-            ethConnected = true;
-        }
-        feedWatchdog();
-    }
-
-    // NTP senkronizasyonu - 10 saniyede bir
-    if (millis() - lastNtpUpdate >= 10000) {
-        lastNtpUpdate = millis();
-        if (ethConnected && ntpManager.hasValidConfig) {
-            updateTimeWithPrecision();
-        }
-    }
-
-    // Ethernet yok mu?
-    if (!ethConnected) {
-        static unsigned long lastStatusSend = 0;
-        if (millis() - lastStatusSend >= 1000) {
-            lastStatusSend = millis();
-            sendStatusToPic('Y');
-        }
-        return;
-    }
-
-    // NTP config yok mu?
-    if (!ntpManager.hasValidConfig || !timeSync.isInitialized) {
-        static unsigned long lastStatusSend = 0;
-        if (millis() - lastStatusSend >= 1000) {
-            lastStatusSend = millis();
-            sendStatusToPic('X');
-        }
-        return;
-    }
-
-    // Epoch geçerli mi?
-    if (getPreciseEpochTime() < 100000) {
-        static unsigned long lastStatusSend = 0;
-        if (millis() - lastStatusSend >= 1000) {
-            lastStatusSend = millis();
-            sendStatusToPic('X');
-        }
-        return;
-    }
-
-    // SENKRON GÖNDERİM
-    handleSyncedDsPICCommunication();
-    
-    delay(1);
+#include <Arduino.h>
+#include <ETH.h>
+#include <WiFiUDP.h>
+#include <WiFiServer.h>
+#include <Preferences.h>
+#include <nvs_flash.h>
+#include <errno.h>
+#include <lwip/sockets.h>
+#include "esp_system.h"
+#include "esp_task_wdt.h"
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "EspTimeHal.h"
+#include "SntpEngine.h"
+#include "SntpServer.h"
+#include "NtpSelect.h"
+#include "ClockDiscipline.h"
+#include "PollController.h"
+#include "Holdover.h"
+#include "WarmStart.h"
+#include "SendScheduler.h"
+#include "SeqLock.h"
+#include "Log.h"
+#include "DsPicFrame.h"
+#include "CivilTime.h"
+#include "MasterCommandParser.h"
+#include "Console.h"
+#include "TimingStats.h"
+#include "TxCompensation.h"
+#include "Pps.h"
+#include "Telemetry.h"
+#include "LoopProfiler.h"
+
+//================================================================================
+// ETHERNET AYARLARI (WT32-ETH01)
+//================================================================================
+#define ETH_CLK_MODE    ETH_CLOCK_GPIO0_IN
+#define ETH_POWER_PIN   16
+#define ETH_TYPE        ETH_PHY_LAN8720
+#define ETH_ADDR        1
+#define ETH_MDC_PIN     23
+#define ETH_MDIO_PIN    18
+
+// Watchdog konfigürasyonu
+#define WDT_TIMEOUT_SECONDS 60
+#define WDT_RESET_INTERVAL 30000
+#define WDT_CRITICAL_OPERATIONS_TIMEOUT 10000
+
+// Watchdog durumu
+struct WatchdogManager {
+    unsigned long lastResetTime = 0;
+    bool isEnabled = false;
+    uint16_t resetCount = 0;
+    uint32_t lastRebootReason = 0;
+} wdtManager;
+
+//================================================================================
+// SERI HABERLEŞME (dsPIC'e tarih/saat gönderimi)
+//================================================================================
+// IDF UART sürücüsü; TX tamponu yok, çerçeve doğrudan donanım FIFO'suna yazılır
+IdfUartPort picPort(UART_NUM_2);
+#define PIC_RX_PIN 4
+#define PIC_TX_PIN 14
+#define PPS_PIN 32                  // WT32-ETH01 CFG pini, başka kullanımı yok
+#define PPS_RMT_CHANNEL RMT_CHANNEL_0
+#define PIC_BAUD_RATE 115200
+#define PIC_RX_BUFFER 256
+
+//================================================================================
+// UART İLETİŞİM (Birinci Kart ile - NTP bilgisi alımı)
+//================================================================================
+IdfUartPort masterUart(UART_NUM_1);
+#define MASTER_RX_PIN 36
+#define MASTER_TX_PIN 33
+#define MASTER_BAUD 115200
+#define MASTER_RX_BUFFER 1024
+#define MASTER_TX_BUFFER 256
+
+// İki UART'ın olay kuyrukları tek kümede; RX görevi yalnızca veri ya da
+// hata olayı geldiğinde uyanır (loop içinde available() yoklaması yok)
+QueueSetHandle_t uartEventSet = NULL;
+
+// 'testmaster' yanıtı RX görevinde toplanır; sonucu konsol görevi
+// beklemeden (MASTER_TEST_TIMEOUT_MS içinde) raporlar
+#define MASTER_TEST_LINE_LEN 48
+#define MASTER_TEST_TIMEOUT_MS 1000
+struct MasterTestReply {
+    volatile bool pending;
+    volatile bool complete;
+    uint8_t length;
+    char line[MASTER_TEST_LINE_LEN];
+    unsigned long startedAt;
+} masterTest;
+
+//================================================================================
+// SERİ KONSOL
+//================================================================================
+// Satır okuyucu beklemez; komutlar sabit tablodan çalışır. Uzun süren
+// tanılar (testsync) commsTask içinde adım adım ilerleyen tek bir arka plan
+// işidir, konsol çıkış zamanlamasından zaman çalamaz.
+ConsoleLineReader consoleReader;
+
+struct ConsoleJob {
+    void (*step)(uint16_t index);       // NULL: iş yok
+    uint16_t index;
+    uint16_t steps;
+    uint32_t intervalMs;
+    unsigned long nextAt;
+} consoleJob;
+
+// NTP komut ayrıştırıcı
+MasterCommandParser masterParser;
+MasterConfigAssembler masterConfig;     // Yarım adresler (ikili), heap kullanmaz
+bool ntpConfigReceived = false;
+
+//================================================================================
+// NTP AYARLARI
+//================================================================================
+#define NTP_UTC_OFFSET_S 10800  // UTC+3; dsPIC saat karesi
+
+// Tüm yapılandırılmış sunucular her turda birlikte sorgulanır; aktif/yedek
+// ayrımı yoktur. Seçim (RFC 5905) her tur yeniden yapılır.
+// Adresler master'dan gelir gelmez bir kez ikili IPv4'e çevrilir ve burada
+// tutulur; istek yolunda ad çözümlemesi yoktur. Yeni konfigürasyon kaydı
+// geçersiz kılar. İleride ad desteği gelirse çözümleme ağ görevinde,
+// istek yolunun dışında ve TTL'li yapılmalıdır.
+#define NTP_MAX_SERVERS SNTP_MAX_SERVERS
+
+struct NTPServerManager {
+    uint32_t servers[NTP_MAX_SERVERS];  // IPv4 (host byte sırası), 0: tanımsız; 0: NTP1, 1: NTP2
+    bool hasValidConfig;           // Geçerli konfigürasyon var mı
+    unsigned long lastSyncTime;    // Son başarılı senkronizasyon zamanı
+    long timeOffset;               // Lokal saat düzeltme offseti (ms)
+    uint8_t reach[NTP_MAX_SERVERS];     // Son 8 turun cevap bitleri (RFC 5905 reach)
+    char tally[NTP_MAX_SERVERS];        // Son seçim: '*' sistem, '+' birleşik, '-' kümeden atıldı, 'x' yanlış, ' ' cevap yok
+} ntpManager;
+
+// Sorgu aralığı sabit değil: iburst ile başlar, disiplin yakınsadıkça
+// 16 s'den 1024 s'ye kadar uzar (PollController). Tur başlangıcı ağ
+// görevinde tutulur.
+unsigned long lastNtpRoundAt = 0;
+
+// Hassas senkronizasyon icin ayri, bloklamayan SNTP soketi
+#define SNTP_LOCAL_PORT 4123
+WiFiUDP sntpUDP;
+WiFiUdpTransport sntpTransport(sntpUDP);
+EspMonotonicClock monotonicClock;
+SntpEngine sntpEngine(sntpTransport, monotonicClock);
+bool sntpSocketOpen = false;
+
+// İsteğe bağlı SNTP sunucusu: paneller disiplinli saati UDP 123'ten alır.
+// Ağ görevinde, timeSync'in sahibi olarak doğrudan çalışır; her turda en
+// fazla SNTP_SERVER_PACKETS_PER_PASS istek işlenir. İstekler lwIP soketinden
+// doğrudan sunucunun 48 baytlık tamponuna alınır (WiFiUDP ayırması yok).
+#define SNTP_SERVER_PACKETS_PER_PASS 8
+LwipUdpTransport sntpServerTransport;
+SntpServer sntpServer(sntpServerTransport, monotonicClock);
+volatile bool sntpServerEnabled = false;
+bool sntpServerOpen = false;
+
+// Ağ telemetrisi: "GET /metrics" Prometheus metin biçimi. Konsol görevinde
+// istek geldikçe yayınlanmış kopyalardan sabit tampona biçimlenir; çıkış
+// görevine ve zamanlayıcıya dokunulmaz. Tek bağlantı, zaman aşımlı.
+// Cevap soketin gönderim tamponuna MSG_DONTWAIT ile sığdığı kadar yazılır,
+// kalanı sonraki turlarda sürer: yavaş istemci konsol görevini bekletmez.
+#define TELEMETRY_HTTP_PORT 80
+#define TELEMETRY_PATH "/metrics"
+#define TELEMETRY_BUFFER_LEN 12288     // Kova satırları dahil en kötü durum ~8.5 kB
+#define TELEMETRY_HEADER_LEN 128
+#define TELEMETRY_REQUEST_TIMEOUT_MS 1000
+#define TELEMETRY_SEND_TIMEOUT_MS 3000  // Cevabın tamamı bu sürede gitmezse bağlantı kesilir
+WiFiServer telemetryServer(TELEMETRY_HTTP_PORT);
+WiFiClient telemetryClient;
+HttpRequestReader telemetryRequest;
+char telemetryBuffer[TELEMETRY_BUFFER_LEN];
+char telemetryHeader[TELEMETRY_HEADER_LEN];
+size_t telemetryHeaderLen = 0;
+size_t telemetryBodyLen = 0;
+size_t telemetrySentLen = 0;        // Başlık + gövdeden soketin kabul ettiği
+bool telemetrySending = false;      // Tampon gönderimde; konsol dokunmaz
+bool telemetryListening = false;
+unsigned long telemetryClientSince = 0;
+uint32_t telemetryServed = 0;
+
+// Bir senkronizasyon turu: her örnekte tüm sunuculara aynı anda istek
+// gider, her sunucunun en düşük RTT'li örneği seçime girer.
+// Ornekler loop() turlarina yayilir, hicbiri cevap beklemez.
+#define NTP_SAMPLES_PER_ROUND 3
+#define NTP_SAMPLE_SPACING_MS 100
+
+struct NtpPollRound {
+    bool active;
+    bool awaitingReply;
+    uint8_t samplesTaken;
+    unsigned long nextSampleAt;
+    uint8_t serverCount;
+    uint8_t slot[NTP_MAX_SERVERS];          // Motor sırası -> NTPn (0: NTP1)
+    NtpPeerFilter filter[NTP_MAX_SERVERS];
+} ntpRound;
+
+//================================================================================
+// KALICI HAFIZA (PREFERENCES)
+//================================================================================
+// Preferences iş parçacığı güvenli değildir ve açıkken begin() başarısız
+// olur. Bu nesneyi açılıştan (görevlerden önce) sonra yalnızca konsol görevi
+// kullanır. Diğer görevler ve konsol komutları yazımı requestNvsWrite() ile
+// ister, serviceNvsWrites() her turda en çok bir kaydı yazar.
+//
+// Flash yazımı iki çekirdekte de önbelleği durdurur. Çıkış görevinin
+// esp_timer yolu IRAM'de olmadığından bu, gönderim anını kaydırır. Bu yüzden
+// çıkış açıkken yazım yalnızca kare gittikten hemen sonraki pencerede başlar:
+// saniye içinde NVS_WRITE_WINDOW_START_MS..NVS_WRITE_WINDOW_END_MS. Pencere
+// PPS kenarından (0 ms) ve sonraki karenin zamanlayıcı uyanışından uzaktır.
+#define NVS_WRITE_WINDOW_START_MS   (TARGET_SEND_MS + 20)
+#define NVS_WRITE_WINDOW_END_MS     (TARGET_SEND_MS + 400)
+enum NvsRecord {
+    NVS_NTP_SERVERS,
+    NVS_WARM_START,
+    NVS_HOLDOVER_CONFIG,
+    NVS_PIC_FRAME_CONFIG,
+    NVS_SNTP_SERVER_CONFIG,
+    NVS_RECORD_COUNT
+};
+volatile bool nvsWriteRequested[NVS_RECORD_COUNT];
+Preferences preferences;
+#define PREF_NTP_CONFIG_NAMESPACE "ntp-config"
+#define PREF_NTP_SERVER1_KEY "ntpServer1"   // Eski metin kaydı, yalnızca okunur
+#define PREF_NTP_SERVER2_KEY "ntpServer2"
+#define PREF_NTP_IP1_KEY "ntpIp1"
+#define PREF_NTP_IP2_KEY "ntpIp2"
+#define PREF_HOLDOVER_NAMESPACE "holdover"
+#define PREF_HOLDOVER_MAX_KEY "maxErrUs"
+#define PREF_HOLDOVER_FLAG_KEY "qualFlag"
+#define PREF_PIC_NAMESPACE "picframe"
+#define PREF_PIC_FORMAT_KEY "format"
+#define PREF_PIC_PPS_KEY "pps"
+#define PREF_SNTP_SERVER_NAMESPACE "ntpserver"
+#define PREF_SNTP_SERVER_KEY "enabled"
+#define PREF_WARM_START_NAMESPACE "warmstart"
+#define PREF_WARM_START_KEY "state"
+
+//================================================================================
+// GLOBAL DEĞİŞKENLER
+//================================================================================
+volatile bool ethConnected = false;
+
+// Açılış bloklamaz: ağ, NTP edinimi ve master el sıkışması görevlerde
+// paralel ilerler. Kilometre taşları reset anından (esp_timer) us cinsinden;
+// her alanın tek yazarı vardır (ağ: ağ görevi, ilk kare: çıkış görevi).
+#define BOOT_LINK_WARN_MS 30000
+struct BootTimeline {
+    volatile int64_t tasksStartedUs;
+    volatile int64_t linkUpUs;
+    volatile int64_t firstSyncUs;
+    volatile int64_t firstFrameUs;
+} bootTimeline;
+
+// YENİ: HASSAS ZAMAN YÖNETİMİ EKLE
+struct PrecisionTimeManager {
+    ClockDiscipline discipline;     // Yerel saat -> UTC (faz + frekans düzeltmesi)
+    bool isInitialized;
+    unsigned long driftCaptureTime;
+    uint32_t ntpDelayUs;            // Seçilen örneğin ağ gecikmesi (delta)
+    PollController poll;            // Sorgu aralığı ve disiplin zaman sabiti
+    HoldoverTracker holdover;       // Kaynak kaybında hata sınırı
+    SntpReference reference;        // Sistem sunucusu (SNTP sunucusu stratum/kök değerleri)
+} timeSync;
+
+// Holdover ayarları konsoldan değişir, ağ görevi timeSync'e uygular
+volatile uint32_t holdoverMaxErrorUs = HOLDOVER_DEFAULT_MAX_ERROR_US;
+// Açıkken holdover süresince her kareden sonra dsPIC'e 'H' gider
+volatile bool picQualityFlagEnabled = false;
+#define PIC_STATUS_HOLDOVER 'H'
+
+// dsPIC kare biçimi: v1 ASCII tarih/saat sırayla (varsayılan), v2 her saniye
+// tam zaman + sıra no + kalite + CRC-16. Konsoldan değişir, çıkış görevi bir
+// sonraki hazırlanan karede uygular.
+#define PIC_FORMAT_V1 1
+#define PIC_FORMAT_V2 2
+volatile uint8_t picFrameFormat = PIC_FORMAT_V1;
+
+// Sıcak başlangıç: RTC yavaş belleği yazılım/watchdog resetinde korunur
+// (güç kesintisinde çöp olur, CRC ayıklar). NVS kopyası seyrek yazılır.
+enum WarmStartSource {
+    WARM_SOURCE_NONE,
+    WARM_SOURCE_RTC,
+    WARM_SOURCE_NVS
+};
+RTC_NOINIT_ATTR WarmStartState rtcWarmStart;
+WarmStartState warmStart;           // Açılışta yüklenen ve her turda güncellenen kayıt
+SeqLock<WarmStartState> warmStartShared;    // Ağ görevi yazar, NVS yazımı okur
+WarmStartState nvsWarmStart;        // NVS'deki son kopya; açılış ve konsol görevi
+WarmStartState nvsWarmStartQueued;  // NVS'ye istenen son kopya; yalnızca ağ görevi
+int64_t nvsWarmStartQueuedUs = 0;
+WarmStartSource warmStartSource = WARM_SOURCE_NONE;
+
+#define TARGET_SEND_MS 50
+#define SEND_TOLERANCE 2
+
+// Disiplinli zamanın görevler arası kopyası. timeSync'e yalnızca ağ/NTP
+// görevi dokunur ve her değişiklikte buraya yayınlar; çıkış ve konsol
+// görevleri kilitsiz okur (seqlock).
+struct TimeSnapshot {
+    ClockDiscipline clock;
+    bool valid;
+    uint32_t ntpDelayUs;
+    uint32_t pollIntervalS;
+    bool pollBurst;
+    HoldoverTracker holdover;
+};
+SeqLock<TimeSnapshot> timeSnapshot;
+
+// dsPIC gönderimi: esp_timer hedeften PIC_SPIN_GUARD_US önce çıkış görevini
+// uyandırır, görev kalan süreyi kendi çekirdeğinde bekleyip UART'a yazar.
+// Zamanlayıcı, planlayıcı, kare önbelleği, takvim ve TX payı yalnızca çıkış
+// görevinindir; diğer görevler çıkışı picOutputEnabled ile açıp kapatır ve
+// zamanlayıcının kurulmasını PIC_NOTIFY_ARM bildirimiyle ister
+#define PIC_TIMER_MIN_LEAD_US 500   // Zamanlayıcı kurulurken hedefe asgari mesafe
+#define PIC_SPIN_GUARD_US 200
+esp_timer_handle_t picSendTimer = NULL;
+SendScheduler picScheduler((uint32_t)TARGET_SEND_MS * 1000);
+// Bekleyen saniyenin karesi zamanlayıcı kurulurken hazırlanır; gönderim
+// anında yalnızca UART yazımı kalır. Tarih ve saat kareleri sırayla gider.
+PicFrameCache picFrameCache;
+bool picNextIsDate = true;
+uint8_t picFrameSequence = 0;       // v2 sıra no; yalnızca çıkış görevi
+// write() hedeften seri aktarım + sürücü payı kadar erken çağrılır; son
+// durma biti hedefe denk gelir. Pay TX_DONE kesmesiyle her karede ölçülür.
+#define PIC_TX_DONE_TIMEOUT_MS 5
+UartTxCompensator picTxComp(PIC_BAUD_RATE);
+uint32_t picTxLeadUs = 0;           // Kurulu saniyenin erken alma süresi
+// İsteğe bağlı PPS: saniye başında RMT darbesi, ardından gelen kare onu
+// etiketler. Kenar aynı zamanlayıcı ve bekleme döngüsüyle seçilir.
+RmtPulseOutput ppsOutput(PPS_RMT_CHANNEL);
+PpsGenerator pps(ppsOutput);
+volatile bool ppsEnabled = false;
+// Kareler ardışık saniyeler için hazırlandığından takvim artımlı ilerler
+CivilClock picCivil(NTP_UTC_OFFSET_S);
+volatile bool picOutputEnabled = false;     // Tek kelime bayrak; ağ görevi yazar
+volatile bool picSendTimerArmed = false;    // Yalnızca çıkış görevi yazar
+// picPort'a yalnızca çıkış görevi yazar. Zamanlayıcı, durum kodu ve kurulum
+// istekleri görev bildirimi bitleriyle ayrılır; durum kodu ('X'/'Y') ve
+// kurulum isteği ağ görevinden gelir.
+#define PIC_NOTIFY_TIMER        (1UL << 0)
+#define PIC_NOTIFY_STATUS       (1UL << 1)
+#define PIC_NOTIFY_ARM          (1UL << 2)
+volatile char picPendingStatus = 0;
+
+// Zamanlama istatistikleri. Çalışan kopyaları yalnızca sahibi olan görev
+// günceller (gönderim: çıkış görevi, NTP: ağ görevi) ve seqlock ile yayınlar.
+// 'stats reset' yalnızca nesli artırır; her görev kendi kopyasını sıfırlar.
+SendStats sendStats;
+SeqLock<SendStats> sendStatsShared;
+NtpStats ntpStats;
+SeqLock<NtpStats> ntpStatsShared;
+volatile uint32_t statsResetGeneration = 0;
+
+// Görev döngüsü profili: her görev turunu aşamalara böler, kendi kopyasını
+// günceller ve aralıkla (ya da eşik aşımında hemen) seqlock ile yayınlar.
+// Eşiği aşan turlar en uzun aşamasıyla halkaya girer; 'profile' gösterir.
+// Eşikler turun çalışma süresiyle (profileBegin..profileEnd) karşılaştırılır;
+// tur sonundaki vTaskDelay ve tur başındaki olay beklemesi süreye girmez.
+#define PROFILE_PUBLISH_INTERVAL_US 250000
+#define NET_STALL_US        5000    // Tur 1 ms aralıkla; 5 tur aralığı kadar iş takılmadır
+#define COMMS_STALL_US      20000   // Tur 5 ms aralıkla; 4 tur aralığı (konsol baskısı dahil)
+#define UART_RX_STALL_US    2000    // Olayla uyanır; bayt boşaltımı 2 ms'yi aşmamalı
+#define OUTPUT_STALL_US     2000    // Olayla uyanır; bekleme döngüsü (PIC_SPIN_GUARD_US) dahil
+
+enum NetStage { NET_STAGE_CONFIG, NET_STAGE_SNTP_SERVER, NET_STAGE_LINK, NET_STAGE_NTP, NET_STAGE_OUTPUT, NET_STAGE_COUNT };
+const char* const netStageNames[] = { "istek/ayar", "sntp sunucu", "ag kontrol", "ntp turu", "cikis durumu" };
+enum CommsStage { COMMS_STAGE_CONSOLE, COMMS_STAGE_MASTER_TEST, COMMS_STAGE_JOB, COMMS_STAGE_TELEMETRY, COMMS_STAGE_NVS, COMMS_STAGE_COUNT };
+const char* const commsStageNames[] = { "konsol", "master testi", "konsol isi", "telemetri", "nvs yazimi" };
+enum UartRxStage { UART_STAGE_MASTER, UART_STAGE_PIC, UART_STAGE_COUNTERS, UART_STAGE_COUNT };
+const char* const uartStageNames[] = { "master komut", "dsPIC rx", "hata sayaci" };
+enum OutputStage { OUTPUT_STAGE_SEND, OUTPUT_STAGE_STATS, OUTPUT_STAGE_COUNT };
+const char* const outputStageNames[] = { "dsPIC gonderim", "istatistik" };
+
+struct TaskProfile {
+    const char* task;
+    LoopProfiler work;              // Yalnızca sahibi görev
+    SeqLock<LoopProfiler> shared;
+    int64_t publishedUs;
+    uint32_t resetSeen;
+
+    TaskProfile(const char* taskName, const char* const* names, uint8_t count, uint32_t stallUs)
+        : task(taskName), work(names, count, stallUs), publishedUs(0), resetSeen(0) {
+        shared.write(work);
+    }
+};
+TaskProfile netProfile("ag/NTP", netStageNames, NET_STAGE_COUNT, NET_STALL_US);
+TaskProfile commsProfile("konsol", commsStageNames, COMMS_STAGE_COUNT, COMMS_STALL_US);
+TaskProfile uartRxProfile("UART RX", uartStageNames, UART_STAGE_COUNT, UART_RX_STALL_US);
+TaskProfile outputProfile("dsPIC cikis", outputStageNames, OUTPUT_STAGE_COUNT, OUTPUT_STALL_US);
+volatile uint32_t profileResetGeneration = 0;
+
+//================================================================================
+// GÖREV YERLEŞİMİ
+//================================================================================
+// Çekirdek 1: dsPIC çıkış görevi (yüksek öncelik), yalnızca zaman kritik yazım
+// Çekirdek 0: ağ/NTP görevi, UART RX görevi (olay kuyruğu) ve konsol görevi
+#define OUTPUT_TASK_CORE        1
+#define OUTPUT_TASK_PRIORITY    (configMAX_PRIORITIES - 2)
+#define NET_TASK_CORE           0
+#define NET_TASK_PRIORITY       5
+#define COMMS_TASK_CORE         0
+#define COMMS_TASK_PRIORITY     3
+#define UART_RX_TASK_CORE       0
+#define UART_RX_TASK_PRIORITY   4   // Ağ görevinin altında, konsolun üstünde
+#define UART_RX_EVENT_SET_LEN   (2 * IDF_UART_EVENT_QUEUE_LEN)  // Master + dsPIC
+#define LOG_TASK_CORE           1
+#define LOG_TASK_PRIORITY       1   // Her şeyden düşük; yalnızca boşta log basar
+#define TASK_STACK_SIZE         4096
+
+TaskHandle_t picOutputTaskHandle = NULL;
+TaskHandle_t netTaskHandle = NULL;
+TaskHandle_t commsTaskHandle = NULL;
+TaskHandle_t logTaskHandle = NULL;
+TaskHandle_t uartRxTaskHandle = NULL;
+
+// Diğer görevlerden ağ/NTP görevine istekler
+volatile bool precisionResyncRequested = false;
+volatile bool ntpRoundRequested = false;
+
+// ntpManager sunucu adresleri master/konsol ve ağ görevleri arasında paylaşılır
+SemaphoreHandle_t ntpConfigMutex = NULL;
+
+//================================================================================
+// FONKSIYON PROTOTİPLERİ
+//================================================================================
+void WiFiEvent(WiFiEvent_t event);
+void initializeNTPServers();
+void saveNtpServers();
+uint32_t loadLegacyNtpServer(const char* key);
+uint8_t collectNtpServers(uint32_t* ips, uint8_t* slots);
+void sendStatusToPic(char status);
+void requestNvsWrite(NvsRecord record);
+bool nvsWriteWindowOpen();
+void serviceNvsWrites();
+void writeNvsRecord(uint8_t record);
+void flushNvsWrites();
+void writePendingPicStatus();
+void loadWarmStart();
+void applyWarmStart();
+void saveWarmStart(uint32_t systemServer);
+void writeWarmStartToNvs();
+void loadHoldoverConfig();
+void saveHoldoverConfig();
+void loadPicFrameConfig();
+void savePicFrameConfig();
+void serviceHoldoverConfig();
+void serviceSntpServer();
+void loadSntpServerConfig();
+void saveSntpServerConfig();
+uint32_t syncErrorUs();
+void printNTPStatus();
+void printNetworkInfo();
+void serviceBootSequence();
+void printBootTimeline();
+void handleSerialCommands();
+void dispatchConsoleLine(const char* line);
+bool startConsoleJob(void (*step)(uint16_t), uint16_t steps, uint32_t intervalMs);
+void serviceConsoleJob();
+
+// Master kart iletişim fonksiyonları
+bool setupUarts();
+void startUartRxTask();
+void handleMasterBytes(const uint8_t* data, size_t len);
+void printUartCounters(const char* name, const UartRxCounters& counters);
+void processMasterNTPCommand(const MasterCommand& cmd);
+void applyReceivedNTPConfig();
+void startMasterTest();
+void serviceMasterTest();
+
+// Watchdog fonksiyonları
+void checkRebootReason();
+void initializeWatchdog();
+void feedWatchdog();
+void disableWatchdog();
+void saveWatchdogStats();
+void gracefulRestart();
+void loadWatchdogStats();
+void printWatchdogStatus();
+
+// Hassas senkronizasyon fonksiyonları
+int64_t getPreciseUtcUs();
+unsigned long getPreciseEpochTime();
+uint16_t getPreciseMillisecond();
+bool updateTimeWithPrecision();
+void serviceNtpRound();
+void recordNtpSample(uint8_t server, const SntpSample& sample);
+void finishNtpRound();
+PicFrameKind nextPicFrameKind();
+uint8_t buildPicFrameFor(char* out, uint32_t second, PicFrameKind kind, const TimeSnapshot& snap);
+void preparePicFrame(uint32_t second, PicFrameKind kind, const TimeSnapshot& snap);
+void handleSyncedDsPICCommunication(const TimeSnapshot& snap);
+void setupPicSendTimer();
+void onPicSendTimer(void* arg);
+void handlePicTimerEvent();
+void armPicSendTimer(const TimeSnapshot& snap);
+void setPicOutputEnabled(bool enabled);
+void startPicSendTimer();
+uint32_t frameDigitsValue(const char* frame);
+void setupPrecisionSync();
+void printSyncStatus();
+void publishTimeSnapshot();
+
+// Zamanlama istatistikleri
+void serviceSendStatsReset();
+void serviceNtpStatsReset();
+void publishSendStats();
+void publishNtpStats();
+void printHistogram(const char* title, const Histogram& hist);
+void printTimingStats();
+void profileBegin(TaskProfile& profile);
+void profileMark(TaskProfile& profile, uint8_t stage);
+void profileEnd(TaskProfile& profile);
+void printTaskProfile(const TaskProfile& profile);
+size_t formatTelemetry(char* buf, size_t capacity);
+void serviceTelemetry();
+void respondTelemetry();
+void continueTelemetrySend();
+
+// Görev fonksiyonları
+void startTasks();
+void picOutputTask(void* param);
+void netTask(void* param);
+void commsTask(void* param);
+void uartRxTask(void* param);
+void logDrainTask(void* param);
+void serviceNetworkAndTime();
+void subscribeTaskWatchdog();
+void lockNtpConfig();
+void unlockNtpConfig();
+
+//================================================================================
+// WATCHDOG FONKSİYONLARI
+//================================================================================
+
+void checkRebootReason() {
+    esp_reset_reason_t reason = esp_reset_reason();
+    wdtManager.lastRebootReason = (uint32_t)reason;
+    
+    Serial.print("Son reboot nedeni: ");
+    switch (reason) {
+        case ESP_RST_POWERON:
+            Serial.println("Normal acilis");
+            break;
+        case ESP_RST_SW:
+            Serial.println("Yazilim restart");
+            break;
+        case ESP_RST_PANIC:
+            Serial.println("Sistem panic");
+            break;
+        case ESP_RST_INT_WDT:
+            Serial.println("Interrupt watchdog timeout");
+            break;
+        case ESP_RST_TASK_WDT:
+            Serial.println("Task watchdog timeout - SISTEM DONMUSTU!");
+            wdtManager.resetCount++;
+            break;
+        case ESP_RST_WDT:
+            Serial.println("Watchdog timeout");
+            wdtManager.resetCount++;
+            break;
+        case ESP_RST_BROWNOUT:
+            Serial.println("Voltaj dusugu");
+            break;
+        default:
+            Serial.printf("Bilinmeyen neden: %d\n", reason);
+            break;
+    }
+}
+
+void initializeWatchdog() {
+    esp_err_t result;
+    
+    result = esp_task_wdt_init(WDT_TIMEOUT_SECONDS, true);
+    
+    if (result == ESP_OK) {
+        result = esp_task_wdt_add(NULL);
+        
+        if (result == ESP_OK) {
+            wdtManager.isEnabled = true;
+            wdtManager.lastResetTime = millis();
+            Serial.printf("Watchdog Timer baslatildi (%d saniye timeout)\n", WDT_TIMEOUT_SECONDS);
+        } else {
+            Serial.printf("HATA: Task watchdog'a eklenemedi: %d\n", result);
+        }
+    } else {
+        Serial.printf("HATA: Watchdog baslatilamadi: %d\n", result);
+    }
+}
+
+void feedWatchdog() {
+    if (wdtManager.isEnabled) {
+        esp_task_wdt_reset();
+        wdtManager.lastResetTime = millis();
+        
+        static unsigned long lastDebugPrint = 0;
+        if (millis() - lastDebugPrint > 30000) {
+            lastDebugPrint = millis();
+            LOGD(LOG_TAG_WDT, "Watchdog resetlendi (Uptime: %lu sn)", millis() / 1000);
+        }
+    }
+}
+
+void disableWatchdog() {
+    if (wdtManager.isEnabled) {
+        // Abone kalan tek görev bile deinit'i ESP_ERR_INVALID_STATE ile reddettirir
+        TaskHandle_t subscribed[] = { picOutputTaskHandle, netTaskHandle, commsTaskHandle, uartRxTaskHandle };
+        for (uint8_t i = 0; i < sizeof(subscribed) / sizeof(subscribed[0]); i++) {
+            if (subscribed[i] != NULL) {
+                esp_task_wdt_delete(subscribed[i]);
+            }
+        }
+        esp_err_t result = esp_task_wdt_deinit();
+        if (result != ESP_OK) {
+            Serial.printf("HATA: Watchdog kapatilamadi: %d\n", result);
+            return;
+        }
+        wdtManager.isEnabled = false;
+        Serial.println("Watchdog devre disi birakildi");
+    }
+}
+
+void saveWatchdogStats() {
+    preferences.begin("wdt-stats", false);
+    preferences.putUShort("resetCount", wdtManager.resetCount);
+    preferences.putULong("lastReboot", wdtManager.lastRebootReason);
+    preferences.putULong("uptime", millis());
+    preferences.end();
+    Serial.println("Watchdog istatistikleri kaydedildi");
+}
+
+void gracefulRestart() {
+    Serial.println("Guvenli sistem restart baslatiliyor...");
+    
+    disableWatchdog();
+    saveWatchdogStats();
+    flushNvsWrites();
+    writeWarmStartToNvs();
+    picPort.flush();
+    masterUart.flush();
+    Serial.flush();
+    
+    Serial.println("3 saniye sonra restart...");
+    delay(3000);
+    ESP.restart();
+}
+
+void loadWatchdogStats() {
+    preferences.begin("wdt-stats", true);
+    wdtManager.resetCount = preferences.getUShort("resetCount", 0);
+    uint32_t lastReboot = preferences.getULong("lastReboot", 0);
+    uint32_t lastUptime = preferences.getULong("uptime", 0);
+    preferences.end();
+    
+    if (wdtManager.resetCount > 0) {
+        Serial.printf("Onceki watchdog reset sayisi: %d\n", wdtManager.resetCount);
+        Serial.printf("Onceki uptime: %lu saniye\n", lastUptime / 1000);
+    }
+}
+
+void printWatchdogStatus() {
+    Serial.println("\n=== WATCHDOG DURUM ===");
+    Serial.printf("Durum: %s\n", wdtManager.isEnabled ? "AKTIF" : "PASIF");
+    Serial.printf("Timeout: %d saniye\n", WDT_TIMEOUT_SECONDS);
+    Serial.printf("Son Reset: %lu ms once\n", millis() - wdtManager.lastResetTime);
+    Serial.printf("Reset Sayisi: %d\n", wdtManager.resetCount);
+    Serial.printf("Uptime: %lu saniye\n", millis() / 1000);
+    Serial.println("=====================\n");
+}
+
+//================================================================================
+// HASSAS ZAMAN SENKRONIZASYONU FONKSİYONLARI
+//================================================================================
+
+int64_t getPreciseUtcUs() {
+    TimeSnapshot snap;
+    timeSnapshot.read(snap);
+    return snap.clock.toUtcUs(esp_timer_get_time());
+}
+
+unsigned long getPreciseEpochTime() {
+    TimeSnapshot snap;
+    timeSnapshot.read(snap);
+    if (!snap.valid) {
+        return 0;
+    }
+    return (unsigned long)(snap.clock.toUtcUs(esp_timer_get_time()) / 1000000);
+}
+
+uint16_t getPreciseMillisecond() {
+    TimeSnapshot snap;
+    timeSnapshot.read(snap);
+    if (!snap.valid) {
+        return millis() % 1000;
+    }
+    return (uint16_t)((snap.clock.toUtcUs(esp_timer_get_time()) / 1000) % 1000);
+}
+
+// Yalnızca ağ/NTP görevinden (ya da görevler başlamadan setup'tan) çağrılır
+void publishTimeSnapshot() {
+    TimeSnapshot snap;
+    snap.clock = timeSync.discipline;
+    snap.valid = timeSync.isInitialized;
+    snap.ntpDelayUs = timeSync.ntpDelayUs;
+    snap.pollIntervalS = timeSync.poll.intervalS();
+    snap.pollBurst = timeSync.poll.inBurst();
+    snap.holdover = timeSync.holdover;
+    timeSnapshot.write(snap);
+}
+
+bool updateTimeWithPrecision() {
+    if (!ntpManager.hasValidConfig) {
+        LOGE(LOG_TAG_NTP, "Hata: Gecerli konfigurasyon yok");
+        return false;
+    }
+
+    if (!ethConnected) {
+        LOGE(LOG_TAG_NTP, "Hata: Ethernet baglantisi yok");
+        return false;
+    }
+
+    if (ntpRound.active) {
+        return false;  // Önceki tur hâlâ sürüyor
+    }
+    lastNtpRoundAt = millis();
+
+    uint32_t ips[NTP_MAX_SERVERS];
+    uint8_t count = collectNtpServers(ips, ntpRound.slot);
+    if (count == 0) {
+        LOGE(LOG_TAG_NTP, "Hata: Gecerli sunucu adresi yok");
+        return false;
+    }
+
+    if (!sntpSocketOpen) {
+        sntpSocketOpen = sntpUDP.begin(SNTP_LOCAL_PORT);
+    }
+    sntpEngine.setServers(ips, count);
+
+    // Çoklu NTP örnekleme - sunucu başına en düşük RTT (örnekler serviceNtpRound'da)
+    ntpRound.active = true;
+    ntpRound.awaitingReply = false;
+    ntpRound.samplesTaken = 0;
+    ntpRound.nextSampleAt = millis();
+    ntpRound.serverCount = count;
+    for (uint8_t i = 0; i < count; i++) {
+        ntpRound.filter[i].reset();
+    }
+    return true;
+}
+
+// Tanımlı sunucu adreslerini ve NTPn sıralarını toplar
+uint8_t collectNtpServers(uint32_t* ips, uint8_t* slots) {
+    uint8_t count = 0;
+
+    lockNtpConfig();
+    for (uint8_t slot = 0; slot < NTP_MAX_SERVERS; slot++) {
+        if (ntpManager.servers[slot] == 0) {
+            continue;
+        }
+        ips[count] = ntpManager.servers[slot];
+        slots[count] = slot;
+        count++;
+    }
+    unlockNtpConfig();
+    return count;
+}
+
+void serviceNtpRound() {
+    if (!ntpRound.active) {
+        return;
+    }
+
+    if (ntpRound.awaitingReply) {
+        SntpStatus status = sntpEngine.poll();
+        if (status == SNTP_PENDING) {
+            return;
+        }
+        ntpRound.awaitingReply = false;
+        ntpRound.samplesTaken++;
+        for (uint8_t i = 0; i < ntpRound.serverCount; i++) {
+            if (sntpEngine.serverStatus(i) == SNTP_COMPLETE) {
+                recordNtpSample(i, sntpEngine.sample(i));
+            } else {
+                ntpStats.recordFailure(ntpRound.slot[i]);
+            }
+        }
+    } else if ((long)(millis() - ntpRound.nextSampleAt) >= 0) {
+        if (sntpEngine.startRequest()) {
+            ntpRound.awaitingReply = true;
+            return;
+        }
+        for (uint8_t i = 0; i < ntpRound.serverCount; i++) {
+            ntpStats.recordFailure(ntpRound.slot[i]);
+        }
+        ntpRound.samplesTaken++;
+    } else {
+        return;
+    }
+
+    if (ntpRound.samplesTaken >= NTP_SAMPLES_PER_ROUND) {
+        finishNtpRound();
+    } else {
+        ntpRound.nextSampleAt = millis() + NTP_SAMPLE_SPACING_MS;
+    }
+}
+
+void recordNtpSample(uint8_t server, const SntpSample& sample) {
+    uint8_t slot = ntpRound.slot[server];
+    ntpStats.recordReply(slot, sample.delayUs);
+    if (timeSync.isInitialized) {
+        int64_t midLocalUs = sample.t1LocalUs + (sample.t4LocalUs - sample.t1LocalUs) / 2;
+        ntpStats.recordOffset(slot, midLocalUs + sample.offsetUs - timeSync.discipline.toUtcUs(midLocalUs));
+    }
+
+    // En düşük ağ gecikmeli örnek en az asimetri hatası taşır
+    ntpRound.filter[server].add(sample);
+}
+
+void finishNtpRound() {
+    ntpRound.active = false;
+
+    NtpCandidate cands[NTP_MAX_SERVERS];
+    uint8_t candCount = 0;
+    for (uint8_t i = 0; i < ntpRound.serverCount; i++) {
+        uint8_t slot = ntpRound.slot[i];
+        bool replied = ntpRound.filter[i].hasSample();
+        ntpManager.reach[slot] = (uint8_t)((ntpManager.reach[slot] << 1) | (replied ? 1 : 0));
+        ntpManager.tally[slot] = ' ';
+        if (replied) {
+            ntpMakeCandidate(i, ntpRound.filter[i].best(), ntpRound.filter[i].jitterUs(), cands[candCount++]);
+        }
+    }
+
+    NtpSelection selection;
+    bool selected = candCount > 0 && ntpSelectAndCombine(cands, candCount, selection);
+    uint32_t previousPollS = timeSync.poll.intervalS();
+    for (uint8_t i = 0; i < candCount; i++) {
+        uint8_t slot = ntpRound.slot[cands[i].server];
+        if (!cands[i].truechimer) {
+            ntpManager.tally[slot] = 'x';
+            if (selected) {
+                ntpStats.recordFalseticker(slot);
+                LOGW(LOG_TAG_NTP, "NTP%u yanlis zaman veriyor, secimden cikarildi", slot + 1);
+            }
+        } else if (!cands[i].survivor) {
+            ntpManager.tally[slot] = '-';
+        } else {
+            ntpManager.tally[slot] = cands[i].server == selection.systemPeer ? '*' : '+';
+        }
+    }
+    publishNtpStats();
+
+    if (selected) {
+        // Birleşik ölçüm sistem sunucusunun T1-T4 ortasına aittir: UTC = yerel + theta
+        int64_t midLocalUs = selection.localUs;
+        DisciplineAction action = timeSync.discipline.update(midLocalUs, midLocalUs + selection.offsetUs);
+        timeSync.poll.update(action, timeSync.discipline.state(),
+                             timeSync.discipline.lastOffsetUs(), timeSync.discipline.jitterUs());
+        timeSync.discipline.setTimeConstant(timeSync.poll.timeConstantS());
+        if (timeSync.poll.intervalS() != previousPollS) {
+            LOGI(LOG_TAG_NTP, "Sorgu araligi: %lu s", (unsigned long)timeSync.poll.intervalS());
+        }
+        LOGD(LOG_TAG_NTP, "Secim: %u aday | %u dogru | %u birlesik | Sistem: NTP%u",
+             candCount, selection.truechimers, selection.survivors,
+             ntpRound.slot[selection.systemPeer] + 1);
+
+        if (action == DISC_IGNORED) {
+            LOGW(LOG_TAG_NTP, "Olcum disiplin dongusunde kullanilmadi");
+            publishTimeSnapshot();
+            return;
+        }
+        if (action == DISC_STEPPED && timeSync.isInitialized) {
+            LOGW(LOG_TAG_NTP, "Saat adim ile ayarlandi (Offset: %ld us)",
+                 (long)timeSync.discipline.lastOffsetUs());
+        }
+
+        const SntpSample& systemSample = ntpRound.filter[selection.systemPeer].best();
+        timeSync.ntpDelayUs = (uint32_t)systemSample.delayUs;
+        timeSync.reference.refId = sntpEngine.serverIp(selection.systemPeer);
+        timeSync.reference.stratum = systemSample.stratum;
+        timeSync.reference.rootDelayUs = systemSample.rootDelayUs + (uint32_t)systemSample.delayUs;
+        timeSync.reference.rootDispersionUs = systemSample.rootDispersionUs;
+        timeSync.isInitialized = true;
+        timeSync.driftCaptureTime = millis();
+        ntpManager.lastSyncTime = millis();
+        if (timeSync.holdover.inHoldover()) {
+            LOGI(LOG_TAG_SYNC, "Holdover bitti (%lu s)", (unsigned long)
+                 ((esp_timer_get_time() - timeSync.holdover.holdoverSinceUs()) / 1000000));
+        }
+        timeSync.holdover.synced(esp_timer_get_time(), syncErrorUs());
+        publishTimeSnapshot();
+        if (bootTimeline.firstSyncUs == 0) {
+            bootTimeline.firstSyncUs = esp_timer_get_time();
+        }
+        if (timeSync.discipline.state() == DISC_SYNC && action != DISC_STEPPED) {
+            saveWarmStart(sntpEngine.serverIp(selection.systemPeer));
+        }
+        ntpStats.markSynced(esp_timer_get_time());
+        publishNtpStats();
+
+        LOGI(LOG_TAG_NTP, "Sync OK | Delay: %luus | Offset: %ldus | Freq: %ldppb | Jitter: %luus",
+             (unsigned long)timeSync.ntpDelayUs,
+             (long)timeSync.discipline.lastOffsetUs(),
+             (long)timeSync.discipline.frequencyPpb(),
+             (unsigned long)timeSync.discipline.jitterUs());
+    } else {
+        if (candCount > 0) {
+            LOGE(LOG_TAG_NTP, "Hata: Sunucular ortak zamanda uzlasamadi (%u aday)", candCount);
+        } else {
+            LOGE(LOG_TAG_NTP, "Hata: Tum orneklemeler basarisiz");
+        }
+        timeSync.poll.roundFailed();
+        if (timeSync.isInitialized && timeSync.holdover.enter(esp_timer_get_time())) {
+            LOGW(LOG_TAG_SYNC, "Holdover: NTP yok, hata siniri %lu us",
+                 (unsigned long)timeSync.holdover.errorBoundUs(esp_timer_get_time()));
+        }
+        publishTimeSnapshot();
+    }
+}
+
+// Başarılı turdaki hata: faz hatası + jitter + yarım gecikme (asimetri payı)
+uint32_t syncErrorUs() {
+    int64_t offset = timeSync.discipline.lastOffsetUs();
+    if (offset < 0) {
+        offset = -offset;
+    }
+    return (uint32_t)offset + timeSync.discipline.jitterUs() + timeSync.ntpDelayUs / 2;
+}
+
+PicFrameKind nextPicFrameKind() {
+    if (picFrameFormat == PIC_FORMAT_V2) {
+        return PIC_FRAME_V2;
+    }
+    return picNextIsDate ? PIC_FRAME_DATE : PIC_FRAME_TIME;
+}
+
+// Tarih ve saat aynı takvimden: UTC + NTP_UTC_OFFSET_S, localtime()/TZ yok.
+// v2 kalitesi ve hata sınırı hedef anına göre hesaplanır. Kare uzunluğu döner.
+uint8_t buildPicFrameFor(char* out, uint32_t second, PicFrameKind kind, const TimeSnapshot& snap) {
+    picCivil.seek(second);
+    if (kind == PIC_FRAME_DATE) {
+        buildPicDateFrame(out, picCivil.day(), picCivil.month(), picCivil.yearOfCentury());
+        return PIC_FRAME_LEN;
+    }
+    if (kind == PIC_FRAME_TIME) {
+        buildPicTimeFrame(out, picCivil.hour(), picCivil.minute(), picCivil.second());
+        return PIC_FRAME_LEN;
+    }
+
+    int64_t targetUtc = (int64_t)second * 1000000 + (int64_t)TARGET_SEND_MS * 1000;
+    int64_t targetLocal = snap.clock.toLocalUs(targetUtc);
+    // Karenin yazılacağı an: hedef eksi TX erken alma süresi (armPicSendTimer
+    // bu kare türü için picTxLeadUs'u kareyi hazırlamadan önce günceller)
+    int64_t writeUtc = targetUtc - picTxLeadUs;
+    uint32_t errorMs = snap.holdover.errorBoundUs(targetLocal) / 1000 + 1;  // Yukarı yuvarlanır
+    PicV2Fields fields;
+    fields.sequence = picFrameSequence;
+    fields.year = picCivil.yearOfCentury();
+    fields.month = picCivil.month();
+    fields.day = picCivil.day();
+    fields.hour = picCivil.hour();
+    fields.minute = picCivil.minute();
+    fields.second = picCivil.second();
+    fields.msPhase = (uint16_t)(((writeUtc % 1000000 + 1000000) % 1000000) / 1000);
+    fields.quality = (uint8_t)snap.holdover.quality(targetLocal);
+    fields.errorMs = errorMs > PIC_V2_ERROR_MS_MAX ? PIC_V2_ERROR_MS_MAX : (uint8_t)errorMs;
+    buildPicV2Frame((uint8_t*)out, fields);
+    return PIC_V2_FRAME_LEN;
+}
+
+// Bekleyen saniyenin karesini önbelleğin arka yuvasına hazırlar
+void preparePicFrame(uint32_t second, PicFrameKind kind, const TimeSnapshot& snap) {
+    int64_t start = esp_timer_get_time();
+    uint8_t length = buildPicFrameFor(picFrameCache.beginPrepare(), second, kind, snap);
+    picFrameCache.publish(second, kind, length, (uint32_t)(esp_timer_get_time() - start));
+}
+
+// Çıkış görevinde, bekleyen saniyenin hedef anında çalışır
+void handleSyncedDsPICCommunication(const TimeSnapshot& snap) {
+    // Sapma, son durma bitinin tahmini iniş anına göre
+    int64_t deviationUs = snap.clock.toUtcUs(esp_timer_get_time()) + picTxLeadUs - picScheduler.pendingTargetUtcUs();
+
+    if (deviationUs < -(int64_t)SEND_TOLERANCE * 1000) {
+        return;  // Saat ayarlandı, hedef henüz gelmedi: aynı saniye yeniden kurulur
+    }
+    if (deviationUs > (int64_t)SEND_TOLERANCE * 1000) {
+        picScheduler.markSkipped();
+        sendStats.updateCounters(picScheduler.missedSeconds(), picScheduler.duplicateSeconds());
+        publishSendStats();
+        return;
+    }
+
+    // Kare hazır olmalı; değilse (ör. saat kurulumdan sonra adım attı)
+    // pencere içinde hazırlanır ve ıskalama olarak sayılır
+    uint32_t second = picScheduler.pendingSecond();
+    PicFrameKind kind = nextPicFrameKind();
+    const char* frame = picFrameCache.frameFor(second, kind);
+    bool cacheHit = (frame != NULL);
+    if (!cacheHit) {
+        preparePicFrame(second, kind, snap);
+        frame = picFrameCache.frameFor(second, kind);
+    }
+
+    uint8_t length = picFrameCache.length();
+    int64_t writeStart = esp_timer_get_time();
+    picPort.write((const uint8_t*)frame, length);
+    uint32_t writeUs = (uint32_t)(esp_timer_get_time() - writeStart);
+
+    // Görev TX_DONE kesmesine kadar uyur; uyanma gecikmesi ölçüme dahildir
+    if (picPort.waitTxDone(PIC_TX_DONE_TIMEOUT_MS)) {
+        int64_t txDoneLocal = esp_timer_get_time();
+        picTxComp.record(length, (uint32_t)(txDoneLocal - writeStart));
+        sendStats.recordTxDone(snap.clock.toUtcUs(txDoneLocal) - picScheduler.pendingTargetUtcUs(),
+                               picTxLeadUs, picTxComp.overheadUs());
+    } else {
+        sendStats.recordTxTimeout();
+    }
+    if (bootTimeline.firstFrameUs == 0) {
+        bootTimeline.firstFrameUs = writeStart;
+        LOGI(LOG_TAG_PIC, "Ilk gecerli kare: acilistan %lu ms", (unsigned long)(writeStart / 1000));
+    }
+
+    // v2 karesi kaliteyi zaten taşır
+    if (kind != PIC_FRAME_V2 && picQualityFlagEnabled && snap.holdover.quality(writeStart) == CLOCK_HOLDOVER) {
+        const uint8_t flag = PIC_STATUS_HOLDOVER;
+        picPort.write(&flag, 1);
+    }
+
+    picScheduler.markSent();
+    sendStats.recordSend(deviationUs);
+    sendStats.recordFrameTiming(picFrameCache.prepareUs(), writeUs, cacheHit);
+    sendStats.updateCounters(picScheduler.missedSeconds(), picScheduler.duplicateSeconds());
+    publishSendStats();
+
+    if (kind == PIC_FRAME_DATE) {
+        LOGD(LOG_TAG_PIC, "Tarih: %06lu%c", frameDigitsValue(frame), frame[6]);
+    } else if (kind == PIC_FRAME_TIME) {
+        LOGD(LOG_TAG_PIC, "Saat: %06lu%c", frameDigitsValue(frame), frame[6]);
+    } else {
+        const uint8_t* v2 = (const uint8_t*)frame;
+        LOGD(LOG_TAG_PIC, "v2 #%u: %02u%02u%02u", v2[2], v2[6], v2[7], v2[8]);
+    }
+    LOGD(LOG_TAG_SYNC, "Hedef: %dms | Sapma: %ldus | Atlanan: %lu",
+         TARGET_SEND_MS, (long)deviationUs, picScheduler.missedSeconds());
+
+    if (kind == PIC_FRAME_V2) {
+        picFrameSequence++;
+    } else {
+        picNextIsDate = !picNextIsDate;
+    }
+}
+
+void setupPicSendTimer() {
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = &onPicSendTimer;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "pic_send";
+
+    esp_err_t result = esp_timer_create(&timerArgs, &picSendTimer);
+    if (result != ESP_OK) {
+        picSendTimer = NULL;
+        Serial.printf("HATA: dsPIC gonderim zamanlayicisi olusturulamadi: %d\n", result);
+    }
+}
+
+// esp_timer görevinde çalışır; yalnızca çıkış görevini uyandırır
+void onPicSendTimer(void* arg) {
+    xTaskNotify(picOutputTaskHandle, PIC_NOTIFY_TIMER, eSetBits);
+}
+
+void handlePicTimerEvent() {
+    TimeSnapshot snap;
+    timeSnapshot.read(snap);
+
+    if (!picOutputEnabled || !snap.valid) {
+        picScheduler.resetSequence();
+        picSendTimerArmed = false;
+        return;
+    }
+
+    // Zamanlayıcı PPS kenarı için kurulduysa önce darbe, sonra kare için yeniden kurulur
+    uint32_t second = picScheduler.pendingSecond();
+    if (ppsEnabled && pps.due(second, snap.clock.toUtcUs(esp_timer_get_time()), 0)) {
+        int64_t edgeLocal = snap.clock.toLocalUs(PpsGenerator::edgeUtcUs(second));
+        if (edgeLocal - esp_timer_get_time() <= 2 * PIC_SPIN_GUARD_US) {
+            while (esp_timer_get_time() < edgeLocal) {
+            }
+            int64_t edgeAt = esp_timer_get_time();
+            if (pps.fire(second)) {
+                sendStats.recordPps(snap.clock.toUtcUs(edgeAt) - PpsGenerator::edgeUtcUs(second));
+            }
+        }
+        armPicSendTimer(snap);
+        return;
+    }
+
+    // Son PIC_SPIN_GUARD_US bu çekirdekte beklenir. Saat arada ayarlandıysa
+    // ve yazım anı hâlâ uzaktaysa zamanlayıcı aynı saniye için yeniden kurulur.
+    int64_t writeLocal = snap.clock.toLocalUs(picScheduler.pendingTargetUtcUs()) - picTxLeadUs;
+    if (writeLocal - esp_timer_get_time() <= 2 * PIC_SPIN_GUARD_US) {
+        while (esp_timer_get_time() < writeLocal) {
+        }
+        handleSyncedDsPICCommunication(snap);
+    }
+    armPicSendTimer(snap);
+}
+
+// Bir sonraki hedef saniyenin +TARGET_SEND_MS anını disiplinli saatten
+// yerel zamana çevirip tek seferlik zamanlayıcıyı kurar. Yazım anı kare
+// uzunluğuna göre TX gecikmesi kadar erkendir.
+void armPicSendTimer(const TimeSnapshot& snap) {
+    PicFrameKind kind = nextPicFrameKind();
+    picTxLeadUs = picTxComp.leadUs(picFrameLength(kind));
+
+    int64_t nowUtc = snap.clock.toUtcUs(esp_timer_get_time());
+    int64_t targetUtc = picScheduler.planNext(nowUtc, PIC_TIMER_MIN_LEAD_US + picTxLeadUs);
+    int64_t wakeLocal = snap.clock.toLocalUs(targetUtc) - picTxLeadUs - PIC_SPIN_GUARD_US;
+    // PPS kenarı karenin saniyesinin başında, kareden TARGET_SEND_MS önce
+    uint32_t second = picScheduler.pendingSecond();
+    if (ppsEnabled && pps.due(second, nowUtc, PIC_TIMER_MIN_LEAD_US)) {
+        wakeLocal = snap.clock.toLocalUs(PpsGenerator::edgeUtcUs(second)) - PIC_SPIN_GUARD_US;
+    }
+
+    // Aynı saniye yeniden kuruluyorsa kare zaten hazırdır
+    if (picFrameCache.frameFor(picScheduler.pendingSecond(), kind) == NULL) {
+        preparePicFrame(picScheduler.pendingSecond(), kind, snap);
+    }
+
+    int64_t delayUs = wakeLocal - esp_timer_get_time();
+    if (delayUs < 0) {
+        delayUs = 0;
+    }
+    picSendTimerArmed = (esp_timer_start_once(picSendTimer, (uint64_t)delayUs) == ESP_OK);
+}
+
+// Ağ görevinden çağrılır; zamanlayıcıya dokunmaz, kurulumu çıkış görevine bırakır
+void setPicOutputEnabled(bool enabled) {
+    picOutputEnabled = enabled;
+    if (enabled && !picSendTimerArmed && picOutputTaskHandle != NULL) {
+        xTaskNotify(picOutputTaskHandle, PIC_NOTIFY_ARM, eSetBits);
+    }
+}
+
+// Çıkış görevinde: çıkış açıldıysa ve zamanlayıcı kurulu değilse kurar.
+// Aynı uyanışta zamanlayıcı olayı zaten kurduysa bir şey yapmaz.
+void startPicSendTimer() {
+    if (!picOutputEnabled || picSendTimerArmed || picSendTimer == NULL) {
+        return;
+    }
+    TimeSnapshot snap;
+    timeSnapshot.read(snap);
+    if (snap.valid) {
+        armPicSendTimer(snap);
+    }
+}
+
+// Kare içeriğini log olayına tam sayı olarak taşımak için (6 rakam)
+uint32_t frameDigitsValue(const char* frame) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < 6; i++) {
+        value = value * 10 + (uint32_t)(frame[i] - '0');
+    }
+    return value;
+}
+
+void setupPrecisionSync() {
+    setPicOutputEnabled(false);
+
+    timeSync.discipline.reset();
+    timeSync.poll.reset();
+    timeSync.discipline.setTimeConstant(timeSync.poll.timeConstantS());
+    timeSync.isInitialized = false;
+    timeSync.driftCaptureTime = 0;
+    timeSync.ntpDelayUs = 0;
+    timeSync.holdover.reset();
+    applyWarmStart();
+    publishTimeSnapshot();
+
+    Serial.println("\n=== HASSAS SENKRONIZASYON SISTEMI ===");
+    Serial.printf("Hedef gonderim zamani: %dms\n", TARGET_SEND_MS);
+    Serial.printf("Tolerans: ±%dms\n", SEND_TOLERANCE);
+    Serial.println("=====================================\n");
+
+    if (ethConnected && ntpManager.hasValidConfig) {
+        Serial.println("Ilk hassas NTP senkronizasyonu baslatiliyor...");
+        updateTimeWithPrecision();
+    }
+}
+
+void printSyncStatus() {
+    TimeSnapshot snap;
+    timeSnapshot.read(snap);
+    const ClockDiscipline& clock = snap.clock;
+
+    Serial.println("\n=== SENKRONIZASYON DURUMU ===");
+    Serial.printf("Hassas zaman: %s\n", snap.valid ? "AKTIF" : "PASIF");
+    Serial.printf("Epoch: %lu\n", getPreciseEpochTime());
+    Serial.printf("Milisaniye: %u / 1000\n", getPreciseMillisecond());
+    Serial.printf("Hedef gonderim: %dms (±%dms)\n", TARGET_SEND_MS, SEND_TOLERANCE);
+    Serial.printf("Son NTP: %lu ms once\n", millis() - ntpManager.lastSyncTime);
+    Serial.printf("Son gecikme: %lu us\n", (unsigned long)snap.ntpDelayUs);
+    Serial.printf("Disiplin: %s\n",
+                  clock.state() == DISC_SYNC ? "SYNC" :
+                  clock.state() == DISC_FREQ ? "FREKANS OLCUMU" : "YOK");
+    Serial.printf("Son faz hatasi: %ld us\n", (long)clock.lastOffsetUs());
+    Serial.printf("Frekans duzeltmesi: %+.3f ppm\n", clock.frequencyPpb() / 1000.0);
+    Serial.printf("Jitter: %lu us\n", (unsigned long)clock.jitterUs());
+    Serial.printf("Zaman sabiti: %lu s\n", (unsigned long)clock.timeConstant());
+    Serial.printf("Sorgu araligi: %lu s%s\n", (unsigned long)snap.pollIntervalS,
+                  snap.pollBurst ? " (iburst)" : "");
+    Serial.printf("Adim sayisi: %lu\n", (unsigned long)clock.stepCount());
+    Serial.printf("Sicak baslangic: %s | Kayit: %s (%lu tur)\n", clock.warmStarted() ? "EVET" : "HAYIR",
+                  warmStartSource == WARM_SOURCE_RTC ? "RTC" :
+                  warmStartSource == WARM_SOURCE_NVS ? "NVS" : "YOK",
+                  (unsigned long)warmStart.syncCount);
+    int64_t nowUs = esp_timer_get_time();
+    ClockQuality quality = snap.valid ? snap.holdover.quality(nowUs) : CLOCK_UNLOCKED;
+    Serial.printf("Saat kalitesi: %s\n", quality == CLOCK_LOCKED ? "KILITLI" :
+                  quality == CLOCK_HOLDOVER ? "HOLDOVER" : "GUVENILMEZ");
+    if (snap.holdover.hasSync()) {
+        Serial.printf("Hata siniri: %lu us (esik %lu us)\n",
+                      (unsigned long)snap.holdover.errorBoundUs(nowUs),
+                      (unsigned long)snap.holdover.maxErrorUs());
+    }
+    if (snap.holdover.inHoldover()) {
+        Serial.printf("Holdover suresi: %lu s\n",
+                      (unsigned long)((nowUs - snap.holdover.holdoverSinceUs()) / 1000000));
+    }
+    Serial.printf("Zamanlayici: %s\n", picSendTimerArmed ? "KURULU" : "BEKLEMEDE");
+    Serial.printf("Gonderilen kare: %lu\n", (unsigned long)picScheduler.sentCount());
+    Serial.printf("Atlanan saniye: %lu\n", (unsigned long)picScheduler.missedSeconds());
+    Serial.printf("Tekrarlanan saniye: %lu\n", (unsigned long)picScheduler.duplicateSeconds());
+    Serial.println("============================\n");
+}
+
+//================================================================================
+// ZAMANLAMA ISTATISTIKLERI
+//================================================================================
+
+// Çıkış görevinden çağrılır
+void serviceSendStatsReset() {
+    static uint32_t seenGeneration = 0;
+    if (seenGeneration != statsResetGeneration) {
+        seenGeneration = statsResetGeneration;
+        sendStats.reset(esp_timer_get_time(), picScheduler.missedSeconds(),
+                        picScheduler.duplicateSeconds());
+        publishSendStats();
+    }
+}
+
+// Ağ/NTP görevinden çağrılır
+void serviceNtpStatsReset() {
+    static uint32_t seenGeneration = 0;
+    if (seenGeneration != statsResetGeneration) {
+        seenGeneration = statsResetGeneration;
+        ntpStats.reset(esp_timer_get_time());
+        publishNtpStats();
+    }
+}
+
+void publishSendStats() {
+    sendStatsShared.write(sendStats);
+}
+
+void publishNtpStats() {
+    ntpStatsShared.write(ntpStats);
+}
+
+void printHistogram(const char* title, const Histogram& hist) {
+    Serial.printf("%s: n=%lu", title, (unsigned long)hist.count());
+    if (hist.count() == 0) {
+        Serial.println();
+        return;
+    }
+    Serial.printf(" | ort %ld | min %ld | maks %ld | p50<=%ld | p99<=%ld us\n",
+                  (long)hist.mean(), (long)hist.minValue(), (long)hist.maxValue(),
+                  (long)hist.percentileBound(50), (long)hist.percentileBound(99));
+
+    char label[24];
+    for (uint8_t i = 0; i < hist.bucketCount(); i++) {
+        if (hist.bucket(i) == 0) {
+            continue;  // Yalnızca dolu kovalar
+        }
+        hist.formatBucketLabel(i, label, sizeof(label));
+        Serial.printf("  %-14s %lu\n", label, (unsigned long)hist.bucket(i));
+    }
+}
+
+void printTimingStats() {
+    SendStats send;
+    NtpStats ntp;
+    sendStatsShared.read(send);
+    ntpStatsShared.read(ntp);
+    int64_t nowUs = esp_timer_get_time();
+
+    Serial.println("\n=== ZAMANLAMA ISTATISTIKLERI ===");
+    Serial.printf("Sifirlamadan beri: %lu s\n", (unsigned long)((nowUs - send.sinceLocalUs) / 1000000));
+    Serial.printf("Gonderilen: %lu | Atlanan: %lu | Tekrarlanan: %lu\n",
+                  (unsigned long)send.sent, (unsigned long)send.missed, (unsigned long)send.duplicate);
+    char title[40];
+    snprintf(title, sizeof(title), "Gonderim sapmasi (+%dms)", TARGET_SEND_MS);
+    printHistogram(title, send.offsetUs);
+    Serial.printf("TX telafisi: %lu us erken (seri %lu + surucu %lu) | TX bitti zaman asimi: %lu\n",
+                  (unsigned long)send.txLeadUs, (unsigned long)(send.txLeadUs - send.txOverheadUs),
+                  (unsigned long)send.txOverheadUs, (unsigned long)send.txTimeouts);
+    printHistogram("Son durma biti kalan hata", send.txResidualUs);
+    if (send.ppsPulses > 0) {
+        Serial.printf("PPS darbesi: %lu\n", (unsigned long)send.ppsPulses);
+        printHistogram("PPS kenar sapmasi", send.ppsOffsetUs);
+    }
+    // Hazırlama artık gönderim penceresinin dışında; pencerede yalnızca yazım kalır
+    Serial.printf("Kare onbellegi iskalama: %lu\n", (unsigned long)send.cacheMisses);
+    printHistogram("Kare hazirlama (pencere disi)", send.prepareUs);
+    printHistogram("UART yazimi (pencere ici)", send.writeUs);
+
+    for (uint8_t i = 0; i < STATS_NTP_SERVERS; i++) {
+        const NtpServerStats& server = ntp.server[i];
+        if (server.replies == 0 && server.failures == 0) {
+            continue;  // Yapılandırılmamış sunucu
+        }
+        Serial.printf("-- NTP%u: cevap %lu | hata %lu | yanlis %lu --\n", i + 1,
+                      (unsigned long)server.replies, (unsigned long)server.failures,
+                      (unsigned long)server.falsetickers);
+        printHistogram("RTT", server.rttUs);
+        printHistogram("Offset", server.offsetUs);
+    }
+
+    if (ntp.lastGoodSyncLocalUs != 0) {
+        Serial.printf("Son basarili senkronizasyon: %lu ms once\n",
+                      (unsigned long)((nowUs - ntp.lastGoodSyncLocalUs) / 1000));
+    } else {
+        Serial.println("Son basarili senkronizasyon: YOK");
+    }
+    Serial.println("================================\n");
+}
+
+//================================================================================
+// GÖREV DÖNGÜSÜ PROFİLİ
+//================================================================================
+
+// profileBegin/Mark/End yalnızca profilin sahibi olan görevden çağrılır
+void profileBegin(TaskProfile& profile) {
+    uint32_t generation = profileResetGeneration;
+    if (profile.resetSeen != generation) {
+        profile.resetSeen = generation;
+        profile.work.reset();
+    }
+    profile.work.beginPass(esp_timer_get_time());
+}
+
+void profileMark(TaskProfile& profile, uint8_t stage) {
+    profile.work.mark(stage, esp_timer_get_time());
+}
+
+void profileEnd(TaskProfile& profile) {
+    int64_t nowUs = esp_timer_get_time();
+    bool stalled = profile.work.endPass(nowUs);
+    if (stalled || nowUs - profile.publishedUs >= PROFILE_PUBLISH_INTERVAL_US) {
+        profile.shared.write(profile.work);
+        profile.publishedUs = nowUs;
+    }
+}
+
+// Konsol görevinden çağrılır
+void printTaskProfile(const TaskProfile& profile) {
+    static LoopProfiler copy;       // Görev yığını yerine
+    profile.shared.read(copy);
+    int64_t nowUs = esp_timer_get_time();
+
+    const Histogram& pass = copy.pass();
+    Serial.printf("-- %s: tur n=%lu | ort %ld | p99<=%ld | maks %ld us | esik %lu us asimi %lu --\n",
+                  profile.task, (unsigned long)pass.count(), (long)pass.mean(),
+                  (long)pass.percentileBound(99), (long)pass.maxValue(),
+                  (unsigned long)copy.stallThresholdUs(), (unsigned long)copy.stallCount());
+    for (uint8_t i = 0; i < copy.stageCount(); i++) {
+        const Histogram& stage = copy.stage(i);
+        Serial.printf("  %-14s ort %ld | p99<=%ld | maks %ld us\n", copy.stageName(i),
+                      (long)stage.mean(), (long)stage.percentileBound(99), (long)stage.maxValue());
+    }
+    for (uint8_t i = 0; i < copy.stallsHeld(); i++) {
+        const ProfileStall& stall = copy.stall(i);
+        Serial.printf("  ! %lu ms once: tur %lu us, en uzun '%s' %lu us\n",
+                      (unsigned long)((nowUs - stall.atUs) / 1000), (unsigned long)stall.passUs,
+                      copy.stageName(stall.stage), (unsigned long)stall.stageUs);
+    }
+}
+
+//================================================================================
+// AĞ TELEMETRİSİ
+//================================================================================
+
+// Yalnızca seqlock kopyaları ve tek kelimelik sayaçlar okunur; herhangi bir
+// görevden çağrılabilir
+size_t formatTelemetry(char* buf, size_t capacity) {
+    TimeSnapshot snap;
+    SendStats send;
+    NtpStats ntp;
+    timeSnapshot.read(snap);
+    sendStatsShared.read(send);
+    ntpStatsShared.read(ntp);
+    int64_t nowUs = esp_timer_get_time();
+    ClockQuality quality = snap.valid ? snap.holdover.quality(nowUs) : CLOCK_UNLOCKED;
+
+    MetricsWriter out(buf, capacity);
+
+    // Senkron durumu
+    out.gauge("timesync_synced", "Disiplinli saat gecerli (1) / degil (0)", snap.valid ? 1 : 0);
+    out.gauge("timesync_quality", "Saat kalitesi: 0 guvenilmez, 1 holdover, 2 kilitli", quality);
+    out.gauge("timesync_discipline_state", "Disiplin: 0 yok, 1 frekans olcumu, 2 sync", snap.clock.state());
+    out.gauge("timesync_offset_us", "Son olcumun faz hatasi", snap.clock.lastOffsetUs());
+    out.gauge("timesync_jitter_us", "Faz hatasi jitter'i", snap.clock.jitterUs());
+    out.gauge("timesync_frequency_ppb", "Frekans duzeltmesi", snap.clock.frequencyPpb());
+    out.gauge("timesync_rtt_us", "Secilen ornegin ag gidis-donus gecikmesi", snap.ntpDelayUs);
+    out.gauge("timesync_poll_interval_seconds", "NTP sorgu araligi", snap.pollIntervalS);
+    out.gauge("timesync_error_bound_us", "Tahmini saat hatasi siniri, senkron yoksa -1",
+              snap.holdover.hasSync() ? (int64_t)snap.holdover.errorBoundUs(nowUs) : -1);
+    out.gauge("timesync_last_sync_age_seconds", "Son basarili NTP turundan beri, hic yoksa -1",
+              ntp.lastGoodSyncLocalUs != 0 ? (nowUs - ntp.lastGoodSyncLocalUs) / 1000000 : -1);
+    out.counter("timesync_steps_total", "Saatin dogrudan ayarlandigi olcumler", snap.clock.stepCount());
+
+    // NTP sunuculari
+    char labels[24];
+    out.family("timesync_ntp_replies_total", "counter", "Sunucu cevaplari");
+    for (uint8_t i = 0; i < STATS_NTP_SERVERS; i++) {
+        snprintf(labels, sizeof(labels), "server=\"%u\"", i + 1);
+        out.sample("timesync_ntp_replies_total", labels, ntp.server[i].replies);
+    }
+    out.family("timesync_ntp_failures_total", "counter", "Zaman asimi / gonderim hatasi");
+    for (uint8_t i = 0; i < STATS_NTP_SERVERS; i++) {
+        snprintf(labels, sizeof(labels), "server=\"%u\"", i + 1);
+        out.sample("timesync_ntp_failures_total", labels, ntp.server[i].failures);
+    }
+    out.family("timesync_ntp_falsetickers_total", "counter", "Secimde yanlis zaman verdigi turlar");
+    for (uint8_t i = 0; i < STATS_NTP_SERVERS; i++) {
+        snprintf(labels, sizeof(labels), "server=\"%u\"", i + 1);
+        out.sample("timesync_ntp_falsetickers_total", labels, ntp.server[i].falsetickers);
+    }
+    out.family("timesync_ntp_rtt_us", "histogram", "Sunucu gidis-donus gecikmesi (istatistik sifirlamadan beri)");
+    for (uint8_t i = 0; i < STATS_NTP_SERVERS; i++) {
+        snprintf(labels, sizeof(labels), "server=\"%u\"", i + 1);
+        out.histogram("timesync_ntp_rtt_us", labels, ntp.server[i].rttUs);
+    }
+
+    // Gönderim doğruluğu
+    out.gauge("timesync_stats_window_seconds", "Istatistik sifirlamadan beri", (nowUs - send.sinceLocalUs) / 1000000);
+    out.counter("timesync_frames_sent_total", "dsPIC'e gonderilen kare", send.sent);
+    out.counter("timesync_missed_seconds_total", "Atlanan saniye", send.missed);
+    out.counter("timesync_duplicate_seconds_total", "Tekrarlanan saniye", send.duplicate);
+    out.counter("timesync_cache_misses_total", "Pencere icinde hazirlanan kare", send.cacheMisses);
+    out.counter("timesync_tx_timeouts_total", "TX bitti olayi gelmeyen kare", send.txTimeouts);
+    out.counter("timesync_pps_pulses_total", "PPS darbesi", send.ppsPulses);
+    out.family("timesync_send_offset_us", "histogram", "Son durma biti - hedef (tahmini)");
+    out.histogram("timesync_send_offset_us", NULL, send.offsetUs);
+    out.family("timesync_tx_residual_us", "histogram", "Son durma biti - hedef (TX bitti olcumu)");
+    out.histogram("timesync_tx_residual_us", NULL, send.txResidualUs);
+
+    // Sağlık
+    out.counter("timesync_watchdog_resets_total", "Watchdog kaynakli resetler", wdtManager.resetCount);
+    out.gauge("timesync_reset_reason", "Son reset nedeni (esp_reset_reason_t)", wdtManager.lastRebootReason);
+    out.gauge("timesync_heap_free_bytes", "Bos heap", esp_get_free_heap_size());
+    out.gauge("timesync_heap_min_free_bytes", "Acilistan beri en dusuk bos heap", esp_get_minimum_free_heap_size());
+    out.gauge("timesync_uptime_seconds", "Calisma suresi", nowUs / 1000000);
+    out.counter("timesync_sntp_server_replies_total", "SNTP sunucusunun cevaplari", sntpServer.counters().replies);
+
+    if (out.overflowed()) {
+        LOGW(LOG_TAG_NET, "Telemetri tamponu yetmedi (%u bayt)", (unsigned)capacity);
+    }
+    return out.length();
+}
+
+// Konsol görevinden çağrılır; hiçbir adım beklemez. Bağlantı gelince istek
+// satırları tampondaki kadar okunur, başlıklar bitince cevap hazırlanır ve
+// soket kabul ettikçe parça parça yazılır; bitene kadar yeni istek okunmaz.
+void serviceTelemetry() {
+    if (!telemetryListening) {
+        if (!ethConnected) {
+            return;
+        }
+        telemetryServer.begin();
+        telemetryServer.setNoDelay(true);
+        telemetryListening = true;
+        LOGI(LOG_TAG_NET, "Telemetri: HTTP %d " TELEMETRY_PATH, TELEMETRY_HTTP_PORT);
+    }
+
+    if (!telemetryClient) {
+        telemetryClient = telemetryServer.available();
+        if (!telemetryClient) {
+            return;
+        }
+        telemetryRequest.reset();
+        telemetryClientSince = millis();
+    }
+
+    if (telemetrySending) {
+        continueTelemetrySend();
+        return;
+    }
+    while (telemetryClient.available() > 0) {
+        if (telemetryRequest.feed((char)telemetryClient.read())) {
+            respondTelemetry();
+            continueTelemetrySend();
+            return;
+        }
+    }
+    if (!telemetryClient.connected() || millis() - telemetryClientSince >= TELEMETRY_REQUEST_TIMEOUT_MS) {
+        telemetryClient.stop();
+    }
+}
+
+// Cevabı tampona hazırlar; yazım continueTelemetrySend'de
+void respondTelemetry() {
+    telemetryBodyLen = 0;
+    const char* status = "404 Not Found";
+    if (telemetryRequest.isGet(TELEMETRY_PATH)) {
+        telemetryBodyLen = formatTelemetry(telemetryBuffer, sizeof(telemetryBuffer));
+        status = "200 OK";
+        telemetryServed++;
+    }
+    int headerLen = snprintf(telemetryHeader, sizeof(telemetryHeader),
+                             "HTTP/1.0 %s\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                             "Content-Length: %u\r\nConnection: close\r\n\r\n",
+                             status, (unsigned)telemetryBodyLen);
+    telemetryHeaderLen = headerLen > 0 ? (size_t)headerLen : 0;
+    telemetrySentLen = 0;
+    telemetrySending = true;
+    telemetryClientSince = millis();
+}
+
+// Soket kabul ettiği kadarını alır (EAGAIN: tampon dolu, sonraki turda
+// sürer). Tamamı gidince, hata ya da zaman aşımında bağlantı kapanır.
+void continueTelemetrySend() {
+    int fd = telemetryClient.fd();
+    size_t total = telemetryHeaderLen + telemetryBodyLen;
+    bool failed = fd < 0;
+
+    while (!failed && telemetrySentLen < total) {
+        const char* chunk;
+        size_t chunkLen;
+        if (telemetrySentLen < telemetryHeaderLen) {
+            chunk = telemetryHeader + telemetrySentLen;
+            chunkLen = telemetryHeaderLen - telemetrySentLen;
+        } else {
+            chunk = telemetryBuffer + (telemetrySentLen - telemetryHeaderLen);
+            chunkLen = total - telemetrySentLen;
+        }
+        ssize_t written = send(fd, chunk, chunkLen, MSG_DONTWAIT);
+        if (written > 0) {
+            telemetrySentLen += (size_t)written;
+        } else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            failed = true;
+        }
+    }
+
+    bool timedOut = millis() - telemetryClientSince >= TELEMETRY_SEND_TIMEOUT_MS;
+    if (telemetrySentLen >= total || failed || timedOut) {
+        if (telemetrySentLen < total) {
+            LOGW(LOG_TAG_NET, "Telemetri cevabi yarim kaldi (%u / %u bayt)",
+                 (unsigned)telemetrySentLen, (unsigned)total);
+        }
+        telemetryClient.stop();
+        telemetrySending = false;
+    }
+}
+
+//================================================================================
+// NTP FONKSİYONLARI
+//================================================================================
+
+void initializeNTPServers() {
+    ntpManager.hasValidConfig = false;
+    ntpManager.lastSyncTime = 0;
+    ntpManager.timeOffset = 0;
+    for (uint8_t i = 0; i < NTP_MAX_SERVERS; i++) {
+        ntpManager.servers[i] = 0;
+        ntpManager.reach[i] = 0;
+        ntpManager.tally[i] = ' ';
+    }
+
+    // Master karttan gelen kayıtlı sunucuları yükle
+    preferences.begin(PREF_NTP_CONFIG_NAMESPACE, true);
+    uint32_t savedNtp1 = preferences.getULong(PREF_NTP_IP1_KEY, 0);
+    uint32_t savedNtp2 = preferences.getULong(PREF_NTP_IP2_KEY, 0);
+    if (savedNtp1 == 0) {
+        // Önceki sürümün metin kaydı
+        savedNtp1 = loadLegacyNtpServer(PREF_NTP_SERVER1_KEY);
+        savedNtp2 = loadLegacyNtpServer(PREF_NTP_SERVER2_KEY);
+    }
+    preferences.end();
+    
+    if (savedNtp1 != 0) {
+        ntpManager.servers[0] = savedNtp1;
+        ntpManager.servers[1] = savedNtp2;  // 0 olabilir
+        ntpManager.hasValidConfig = true;
+        
+        char ntp1Text[16];
+        char ntp2Text[16];
+        formatIPv4(savedNtp1, ntp1Text, sizeof(ntp1Text));
+        formatIPv4(savedNtp2, ntp2Text, sizeof(ntp2Text));
+        Serial.println("=== KAYITLI NTP KONFIGURASYONU YUKLENDI ===");
+        Serial.printf("NTP1: %s\n", ntp1Text);
+        Serial.printf("NTP2: %s\n", savedNtp2 != 0 ? ntp2Text : "Yok");
+        Serial.println("==========================================");
+    } else {
+        Serial.println("!!! Kayitli NTP konfigurasyonu yok !!!");
+        Serial.println("Master karttan konfigürasyon bekleniyor...");
+    }
+}
+
+// Konsol görevinde (serviceNvsWrites)
+void saveNtpServers() {
+    lockNtpConfig();
+    uint32_t ntp1 = ntpManager.servers[0];
+    uint32_t ntp2 = ntpManager.servers[1];
+    unlockNtpConfig();
+
+    preferences.begin(PREF_NTP_CONFIG_NAMESPACE, false);
+    preferences.putULong(PREF_NTP_IP1_KEY, ntp1);
+    preferences.putULong(PREF_NTP_IP2_KEY, ntp2);
+    preferences.end();
+    LOGI(LOG_TAG_MASTER, "Master NTP sunuculari kalici olarak kaydedildi");
+}
+
+// Metin kaydını yığındaki tamponla okur; yoksa ya da geçersizse 0
+uint32_t loadLegacyNtpServer(const char* key) {
+    char text[16];
+    IPAddress addr;
+    if (preferences.getString(key, text, sizeof(text)) == 0 || !addr.fromString(text)) {
+        return 0;
+    }
+    return fromIPAddress(addr);
+}
+
+// Ağ görevinden çağrılır; kodu çıkış görevine bırakır, porta yazmaz
+void sendStatusToPic(char status) {
+    static char lastLogged = 0;
+    picPendingStatus = status;
+    if (picOutputTaskHandle != NULL) {
+        xTaskNotify(picOutputTaskHandle, PIC_NOTIFY_STATUS, eSetBits);
+    }
+    if (status == lastLogged) {
+        return;  // Kod saniyede bir tekrarlanır; log yalnızca değişimde
+    }
+    lastLogged = status;
+    if (status == 'Y') {
+        LOGW(LOG_TAG_PIC, "Durum: Y (Ethernet yok)");
+    } else if (status == 'X') {
+        LOGW(LOG_TAG_PIC, "Durum: X (NTP yok)");
+    }
+}
+
+// Çıkış görevinde, varsa kare yazımından sonra çağrılır
+void writePendingPicStatus() {
+    char status = picPendingStatus;
+    picPendingStatus = 0;
+    // Bu arada senkron geri geldiyse kareler sürüyor; kod artık geçersiz
+    if (status != 0 && !picOutputEnabled) {
+        picPort.write((const uint8_t*)&status, 1);
+    }
+}
+
+void loadHoldoverConfig() {
+    preferences.begin(PREF_HOLDOVER_NAMESPACE, true);
+    holdoverMaxErrorUs = preferences.getULong(PREF_HOLDOVER_MAX_KEY, HOLDOVER_DEFAULT_MAX_ERROR_US);
+    picQualityFlagEnabled = preferences.getBool(PREF_HOLDOVER_FLAG_KEY, false);
+    preferences.end();
+}
+
+void saveHoldoverConfig() {
+    preferences.begin(PREF_HOLDOVER_NAMESPACE, false);
+    preferences.putULong(PREF_HOLDOVER_MAX_KEY, holdoverMaxErrorUs);
+    preferences.putBool(PREF_HOLDOVER_FLAG_KEY, picQualityFlagEnabled);
+    preferences.end();
+}
+
+void loadPicFrameConfig() {
+    preferences.begin(PREF_PIC_NAMESPACE, true);
+    uint8_t format = preferences.getUChar(PREF_PIC_FORMAT_KEY, PIC_FORMAT_V1);
+    ppsEnabled = preferences.getBool(PREF_PIC_PPS_KEY, false);
+    preferences.end();
+    picFrameFormat = (format == PIC_FORMAT_V2) ? PIC_FORMAT_V2 : PIC_FORMAT_V1;
+}
+
+void savePicFrameConfig() {
+    preferences.begin(PREF_PIC_NAMESPACE, false);
+    preferences.putUChar(PREF_PIC_FORMAT_KEY, picFrameFormat);
+    preferences.putBool(PREF_PIC_PPS_KEY, ppsEnabled);
+    preferences.end();
+}
+
+// RTC kopyası geçerliyse (sıcak reset) o, değilse NVS kopyası kullanılır
+void loadWarmStart() {
+    memset(&nvsWarmStart, 0, sizeof(nvsWarmStart));
+    preferences.begin(PREF_WARM_START_NAMESPACE, true);
+    preferences.getBytes(PREF_WARM_START_KEY, &nvsWarmStart, sizeof(nvsWarmStart));
+    preferences.end();
+    nvsWarmStartQueued = nvsWarmStart;
+
+    if (warmStartValid(rtcWarmStart)) {
+        warmStart = rtcWarmStart;
+        warmStartSource = WARM_SOURCE_RTC;
+    } else if (warmStartValid(nvsWarmStart)) {
+        warmStart = nvsWarmStart;
+        warmStartSource = WARM_SOURCE_NVS;
+    } else {
+        memset(&warmStart, 0, sizeof(warmStart));
+        warmStartSource = WARM_SOURCE_NONE;
+        Serial.println("Sicak baslangic kaydi yok, disiplin sifirdan baslayacak");
+        return;
+    }
+    Serial.printf("Sicak baslangic (%s): %+.3f ppm, sorgu 2^%u s, son ofset %ld us\n",
+                  warmStartSource == WARM_SOURCE_RTC ? "RTC" : "NVS",
+                  warmStart.freqPpb / 1000.0, warmStart.pollExp, (long)warmStart.lastOffsetUs);
+}
+
+// setupPrecisionSync'ten: frekans her zaman geri yüklenir (kristalin
+// özelliği), sorgu aralığı yalnızca son sistem sunucusu hâlâ tanımlıysa
+void applyWarmStart() {
+    if (!warmStartValid(warmStart)) {
+        return;
+    }
+    timeSync.discipline.warmStart(warmStart.freqPpb);
+
+    bool serverKnown = false;
+    lockNtpConfig();
+    for (uint8_t i = 0; i < NTP_MAX_SERVERS; i++) {
+        if (warmStart.lastServer != 0 && ntpManager.servers[i] == warmStart.lastServer) {
+            serverKnown = true;
+        }
+    }
+    unlockNtpConfig();
+
+    if (serverKnown && warmStartSource == WARM_SOURCE_RTC) {
+        timeSync.poll.warmStart(warmStart.pollExp);
+    }
+    timeSync.discipline.setTimeConstant(timeSync.poll.timeConstantS());
+}
+
+// Ağ görevinde, her başarılı SYNC turunda RTC'ye; NVS yazımı yalnızca
+// warmStartNvsDue ise istenir (konsol görevi yazar)
+void saveWarmStart(uint32_t systemServer) {
+    WarmStartState state;
+    memset(&state, 0, sizeof(state));
+    state.freqPpb = timeSync.discipline.frequencyPpb();
+    state.lastOffsetUs = (int32_t)timeSync.discipline.lastOffsetUs();
+    state.lastServer = systemServer;
+    state.pollExp = timeSync.poll.pollExponent();
+    state.syncCount = warmStart.syncCount + 1;
+    warmStartSeal(state);
+
+    warmStart = state;
+    rtcWarmStart = state;
+    warmStartSource = WARM_SOURCE_RTC;
+    warmStartShared.write(state);
+
+    int64_t nowUs = esp_timer_get_time();
+    uint32_t sinceWriteS = (uint32_t)((nowUs - nvsWarmStartQueuedUs) / 1000000);
+    if (warmStartNvsDue(nvsWarmStartQueued, state, sinceWriteS)) {
+        nvsWarmStartQueued = state;
+        nvsWarmStartQueuedUs = nowUs;
+        requestNvsWrite(NVS_WARM_START);
+    }
+}
+
+// Konsol görevinde: ağ görevinin yayınladığı son kayıt, NVS'dekinden farklıysa
+void writeWarmStartToNvs() {
+    WarmStartState state;
+    warmStartShared.read(state);
+    if (!warmStartValid(state) || memcmp(&state, &nvsWarmStart, sizeof(state)) == 0) {
+        return;
+    }
+    preferences.begin(PREF_WARM_START_NAMESPACE, false);
+    preferences.putBytes(PREF_WARM_START_KEY, &state, sizeof(state));
+    preferences.end();
+    nvsWarmStart = state;
+    LOGI(LOG_TAG_SYNC, "Sicak baslangic NVS'ye yazildi (%ld ppb)", (long)state.freqPpb);
+}
+
+// Ağ görevinde: konsoldan gelen eşik timeSync'e uygulanır
+void serviceHoldoverConfig() {
+    uint32_t requested = holdoverMaxErrorUs;
+    if (requested != timeSync.holdover.maxErrorUs()) {
+        timeSync.holdover.setMaxErrorUs(requested);
+        publishTimeSnapshot();
+    }
+}
+
+// Ağ görevinde: soket konsoldaki ayara göre açılır/kapanır, bekleyen
+// istekler disiplinli saatle cevaplanır
+void serviceSntpServer() {
+    if (sntpServerEnabled != sntpServerOpen) {
+        if (sntpServerEnabled) {
+            sntpServerOpen = sntpServerTransport.begin(NTP_PORT);
+            if (!sntpServerOpen) {
+                LOGE(LOG_TAG_NTP, "SNTP sunucusu UDP %d acilamadi", NTP_PORT);
+                sntpServerEnabled = false;
+                return;
+            }
+            sntpServer.reset();
+            LOGI(LOG_TAG_NTP, "SNTP sunucusu acik (UDP %d)", NTP_PORT);
+        } else {
+            sntpServerTransport.stop();
+            sntpServerOpen = false;
+            LOGI(LOG_TAG_NTP, "SNTP sunucusu kapandi");
+        }
+    }
+    if (sntpServerOpen) {
+        sntpServer.service(timeSync.discipline, timeSync.holdover, timeSync.reference,
+                           SNTP_SERVER_PACKETS_PER_PASS);
+    }
+}
+
+void loadSntpServerConfig() {
+    preferences.begin(PREF_SNTP_SERVER_NAMESPACE, true);
+    sntpServerEnabled = preferences.getBool(PREF_SNTP_SERVER_KEY, false);
+    preferences.end();
+}
+
+void saveSntpServerConfig() {
+    preferences.begin(PREF_SNTP_SERVER_NAMESPACE, false);
+    preferences.putBool(PREF_SNTP_SERVER_KEY, sntpServerEnabled);
+    preferences.end();
+}
+
+// Herhangi bir görevden; yazım konsol görevinde pencere açılınca yapılır
+void requestNvsWrite(NvsRecord record) {
+    nvsWriteRequested[record] = true;
+}
+
+// Çıkış kapalıysa her an; açıksa kare gittikten sonraki pencerede
+bool nvsWriteWindowOpen() {
+    if (!picOutputEnabled) {
+        return true;
+    }
+    TimeSnapshot snap;
+    timeSnapshot.read(snap);
+    if (!snap.valid) {
+        return true;
+    }
+    int64_t utcUs = snap.clock.toUtcUs(esp_timer_get_time());
+    int32_t phaseMs = (int32_t)(((utcUs % 1000000 + 1000000) % 1000000) / 1000);
+    return phaseMs >= NVS_WRITE_WINDOW_START_MS && phaseMs < NVS_WRITE_WINDOW_END_MS;
+}
+
+void writeNvsRecord(uint8_t record) {
+    switch (record) {
+        case NVS_NTP_SERVERS:        saveNtpServers(); break;
+        case NVS_WARM_START:         writeWarmStartToNvs(); break;
+        case NVS_HOLDOVER_CONFIG:    saveHoldoverConfig(); break;
+        case NVS_PIC_FRAME_CONFIG:   savePicFrameConfig(); break;
+        case NVS_SNTP_SERVER_CONFIG: saveSntpServerConfig(); break;
+    }
+}
+
+// Konsol görevinde her turda: bekleyen en fazla bir kayıt, böylece tek bir
+// önbellek duraklaması pencerenin içinde kalır
+void serviceNvsWrites() {
+    for (uint8_t i = 0; i < NVS_RECORD_COUNT; i++) {
+        if (!nvsWriteRequested[i]) {
+            continue;
+        }
+        if (!nvsWriteWindowOpen()) {
+            return;
+        }
+        nvsWriteRequested[i] = false;
+        writeNvsRecord(i);
+        return;
+    }
+}
+
+// Restart öncesi: pencere beklenmeden bekleyen her şey yazılır
+void flushNvsWrites() {
+    for (uint8_t i = 0; i < NVS_RECORD_COUNT; i++) {
+        if (nvsWriteRequested[i]) {
+            nvsWriteRequested[i] = false;
+            writeNvsRecord(i);
+        }
+    }
+}
+
+void printNTPStatus() {
+    lockNtpConfig();
+    Serial.println("\n=== NTP DURUM ===");
+    
+    if (!ntpManager.hasValidConfig) {
+        Serial.println("DURUM: KONFIGURASYON YOK!");
+        Serial.println("Master karttan NTP bilgisi bekleniyor...");
+    } else {
+        // Tüm sunucular birlikte sorgulanır; durum son turun seçim sonucudur
+        for (uint8_t i = 0; i < MASTER_NTP_SERVERS; i++) {
+            Serial.printf("NTP%u: ", i + 1);
+            if (ntpManager.servers[i] != 0) {
+                char text[16];
+                formatIPv4(ntpManager.servers[i], text, sizeof(text));
+                Serial.printf("%c %s (Erisim: %03o)\n", ntpManager.tally[i], text, ntpManager.reach[i]);
+            } else {
+                Serial.println("Tanimli degil");
+            }
+        }
+        Serial.println("(* sistem, + birlesik, - kumeden atildi, x yanlis zaman)");
+    }
+    Serial.println("=================\n");
+    unlockNtpConfig();
+}
+
+//================================================================================
+// MASTER KART İLETİŞİM FONKSİYONLARI
+//================================================================================
+
+// UART RX görevinden çağrılır; ayrıştırıcının tek yazarı bu görevdir.
+// Bu yolda Serial'e basılmaz ve UART boşaltılması beklenmez: yalnızca LOG*
+void handleMasterBytes(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        char receivedChar = (char)data[i];
+        MasterCommand cmd;
+
+        if (masterTest.pending && !masterTest.complete) {
+            if (receivedChar == '\n' || receivedChar == '\r') {
+                if (masterTest.length > 0) {
+                    masterTest.line[masterTest.length] = '\0';
+                    masterTest.complete = true;
+                }
+            } else if (masterTest.length < MASTER_TEST_LINE_LEN - 1) {
+                masterTest.line[masterTest.length++] = receivedChar;
+            }
+        }
+
+        if (masterParser.feed(receivedChar, cmd)) {
+            if (cmd.valid) {
+                LOGI(LOG_TAG_MASTER, "Master karttan komut: %03u%03u%c",
+                     cmd.octets[0], cmd.octets[1], cmd.terminator);
+            }
+            processMasterNTPCommand(cmd);
+        }
+    }
+}
+
+void processMasterNTPCommand(const MasterCommand& cmd) {
+    uint8_t server = 0;
+    MasterConfigEvent event = masterConfig.apply(cmd, &server);
+
+    switch (event) {
+        case MASTER_CFG_INVALID:
+            // ACK gönderilmez; master kart aynı parçayı yeniden yollar
+            LOGW(LOG_TAG_MASTER, "Gecersiz komut: %u rakam, sonlandirici %c",
+                 cmd.digitCount, cmd.terminator);
+            break;
+
+        case MASTER_CFG_FIRST_HALF:
+            LOGI(LOG_TAG_MASTER, "NTP%u Part1 alindi: %u.%u", server + 1, cmd.octets[0], cmd.octets[1]);
+            masterUart.print("ACK\r\n");
+            break;
+
+        case MASTER_CFG_SECOND_HALF:
+            LOGW(LOG_TAG_MASTER, "NTP%u Part2 alindi: %u.%u (Part1 eksik)", server + 1,
+                 cmd.octets[0], cmd.octets[1]);
+            break;
+
+        case MASTER_CFG_ADDRESS:
+            // Log olayı en çok dört argüman taşır: sunucu numarası biçimdedir
+            LOGI(LOG_TAG_MASTER, server == 0 ? "NTP1 IP adresi: %u.%u.%u.%u" : "NTP2 IP adresi: %u.%u.%u.%u",
+                 LOG_IPV4(masterConfig.server(server)));
+            masterUart.print("ACK\r\n");
+
+            // NTP2 dizinin son parçasıdır
+            if (server == MASTER_NTP_SERVERS - 1) {
+                applyReceivedNTPConfig();
+            }
+            break;
+    }
+}
+
+void applyReceivedNTPConfig() {
+    uint32_t ntp1 = masterConfig.server(0);
+    uint32_t ntp2 = masterConfig.server(1);
+
+    // 0.0.0.0 tanımsız sunucudur
+    LOGI(LOG_TAG_MASTER, "Master NTP konfigurasyonu: NTP1 %u.%u.%u.%u", LOG_IPV4(ntp1));
+    LOGI(LOG_TAG_MASTER, "Master NTP konfigurasyonu: NTP2 %u.%u.%u.%u", LOG_IPV4(ntp2));
+
+    if (ntp1 != 0) {
+        lockNtpConfig();
+        ntpManager.servers[0] = ntp1;
+        ntpManager.servers[1] = ntp2;
+        ntpManager.hasValidConfig = true;
+        for (uint8_t i = 0; i < NTP_MAX_SERVERS; i++) {
+            ntpManager.reach[i] = 0;
+            ntpManager.tally[i] = ' ';
+        }
+        unlockNtpConfig();
+        
+        requestNvsWrite(NVS_NTP_SERVERS);
+        ntpConfigReceived = true;
+        
+        // Hassas senkronizasyonu başlat (ağ/NTP görevinde)
+        precisionResyncRequested = true;
+        
+        // Yarım adresleri temizle
+        masterConfig.clear();
+        
+        LOGI(LOG_TAG_MASTER, "Yeni NTP konfigurasyonu uygulandi, hassas senkronizasyon baslatildi");
+    }
+}
+
+
+// Yanıtı RX görevi toplar; sonuç serviceMasterTest'te raporlanır
+void startMasterTest() {
+    Serial.println("Master kart baglantisi test ediliyor...");
+    masterTest.complete = false;
+    masterTest.length = 0;
+    masterTest.startedAt = millis();
+    masterTest.pending = true;
+    masterUart.print("TEST\r\n");
+}
+
+// Konsol görevinde her turda; beklemez
+void serviceMasterTest() {
+    if (!masterTest.pending) {
+        return;
+    }
+    if (masterTest.complete) {
+        masterTest.pending = false;
+        Serial.print("Master kart yaniti: ");
+        Serial.println(masterTest.line);
+    } else if (millis() - masterTest.startedAt >= MASTER_TEST_TIMEOUT_MS) {
+        masterTest.pending = false;
+        Serial.println("Master karttan yanit alinamadi");
+    }
+}
+
+void printUartCounters(const char* name, const UartRxCounters& counters) {
+    Serial.printf("%s RX: %lu bayt, %lu uyanis | FIFO tasmasi: %lu | Tampon dolu: %lu\n", name,
+                  (unsigned long)counters.bytes, (unsigned long)counters.wakeups,
+                  (unsigned long)counters.fifoOverflows, (unsigned long)counters.bufferFull);
+    Serial.printf("%s hata: cerceve %lu | parite %lu | break %lu\n", name,
+                  (unsigned long)counters.framingErrors, (unsigned long)counters.parityErrors,
+                  (unsigned long)counters.breaks);
+}
+
+//================================================================================
+// NETWORK FONKSİYONLARI
+//================================================================================
+
+void printNetworkInfo() {
+    Serial.println("\n=== AG BILGILERI ===");
+    Serial.print("IP Adresi: "); Serial.println(ETH.localIP());
+    Serial.print("Gateway: "); Serial.println(ETH.gatewayIP());
+    Serial.print("Subnet Mask: "); Serial.println(ETH.subnetMask());
+    Serial.print("DNS: "); Serial.println(ETH.dnsIP());
+    Serial.print("MAC Adresi: "); Serial.println(ETH.macAddress());
+    Serial.print("Link Durumu: "); Serial.println(ETH.linkUp() ? "Bagli" : "Bagli Degil");
+    Serial.print("Hiz: "); Serial.print(ETH.linkSpeed()); Serial.println(" Mbps");
+    Serial.print("Full Duplex: "); Serial.println(ETH.fullDuplex() ? "Evet" : "Hayir");
+    Serial.println("==================\n");
+}
+
+bool startConsoleJob(void (*step)(uint16_t), uint16_t steps, uint32_t intervalMs) {
+    if (consoleJob.step != NULL) {
+        Serial.println("HATA: Baska bir test suruyor ('stop' ile durdurun)");
+        return false;
+    }
+    consoleJob.step = step;
+    consoleJob.index = 0;
+    consoleJob.steps = steps;
+    consoleJob.intervalMs = intervalMs;
+    consoleJob.nextAt = millis();
+    return true;
+}
+
+// Her çağrıda en fazla bir adım; adımlar arası bekleme commsTask döngüsünde
+void serviceConsoleJob() {
+    if (consoleJob.step == NULL || (long)(millis() - consoleJob.nextAt) < 0) {
+        return;
+    }
+    consoleJob.step(consoleJob.index);
+    consoleJob.nextAt += consoleJob.intervalMs;
+    if (++consoleJob.index >= consoleJob.steps) {
+        consoleJob.step = NULL;
+    }
+}
+
+bool cmdStatus(const char* args) {
+    printNTPStatus();
+    printNetworkInfo();
+    printWatchdogStatus();
+    printBootTimeline();
+    return true;
+}
+
+bool cmdReset(const char* args) {
+    gracefulRestart();
+    return true;
+}
+
+bool cmdWdt(const char* args) {
+    printWatchdogStatus();
+    return true;
+}
+
+bool cmdTestMaster(const char* args) {
+    startMasterTest();
+    return true;
+}
+
+bool cmdMasterInfo(const char* args) {
+    Serial.println("\n=== MASTER KART DURUMU ===");
+    Serial.println("Baglanti: IO36(RX) <-> IO33(TX)");
+    Serial.print("Baudrate: "); Serial.println(MASTER_BAUD);
+    Serial.print("NTP konfig alindi: ");
+    Serial.println(ntpConfigReceived ? "EVET" : "HAYIR");
+    for (uint8_t i = 0; i < MASTER_NTP_SERVERS; i++) {
+        for (uint8_t half = 0; half < 2; half++) {
+            if (masterConfig.hasHalf(i, half)) {
+                Serial.printf("NTP%u Part%u: %u.%u\n", i + 1, half + 1,
+                              masterConfig.octet(i, half * 2), masterConfig.octet(i, half * 2 + 1));
+            }
+        }
+    }
+    printUartCounters("Master", masterUart.counters());
+    printUartCounters("dsPIC", picPort.counters());
+    Serial.println("========================\n");
+    return true;
+}
+
+bool cmdSync(const char* args) {
+    printSyncStatus();
+    return true;
+}
+
+void testSyncStep(uint16_t index) {
+    Serial.printf("T+%us: Epoch=%lu, Ms=%u\n",
+                  index, getPreciseEpochTime(), getPreciseMillisecond());
+}
+
+bool cmdTestSync(const char* args) {
+    if (startConsoleJob(testSyncStep, 10, 1000)) {
+        Serial.println("10 saniye senkronizasyon testi...");
+    }
+    return true;
+}
+
+bool cmdStop(const char* args) {
+    Serial.println(consoleJob.step != NULL ? "Test durduruldu." : "Suren test yok.");
+    consoleJob.step = NULL;
+    return true;
+}
+
+bool cmdStats(const char* args) {
+    if (args[0] == '\0') {
+        printTimingStats();
+        return true;
+    }
+    if (strcmp(args, "reset") == 0) {
+        statsResetGeneration++;
+        Serial.println("Zamanlama istatistikleri sifirlaniyor.");
+        return true;
+    }
+    return false;
+}
+
+bool cmdProfile(const char* args) {
+    if (strcmp(args, "reset") == 0) {
+        profileResetGeneration++;
+        Serial.println("Gorev profili sifirlaniyor.");
+        return true;
+    }
+    if (args[0] != '\0') {
+        return false;
+    }
+    Serial.println("\n=== GOREV PROFILI ===");
+    printTaskProfile(outputProfile);
+    printTaskProfile(netProfile);
+    printTaskProfile(uartRxProfile);
+    printTaskProfile(commsProfile);
+    Serial.println("(! esigi asan son turlar, en yenisi once)");
+    Serial.println("=====================\n");
+    return true;
+}
+
+bool cmdHoldover(const char* args) {
+    if (args[0] == '\0') {
+        Serial.printf("Holdover esigi: %lu us | dsPIC kalite bayragi: %s\n",
+                      (unsigned long)holdoverMaxErrorUs, picQualityFlagEnabled ? "ACIK" : "KAPALI");
+        return true;
+    }
+    if (strncmp(args, "max ", 4) == 0) {
+        char* end;
+        long value = strtol(args + 4, &end, 10);
+        if (end == args + 4 || *end != '\0') {
+            return false;
+        }
+        if (value < HOLDOVER_MIN_MAX_ERROR_US || value > HOLDOVER_MAX_MAX_ERROR_US) {
+            Serial.printf("HATA: Esik %d..%d us olmali\n",
+                          HOLDOVER_MIN_MAX_ERROR_US, HOLDOVER_MAX_MAX_ERROR_US);
+            return true;
+        }
+        holdoverMaxErrorUs = (uint32_t)value;
+        requestNvsWrite(NVS_HOLDOVER_CONFIG);
+        Serial.printf("Holdover esigi: %ld us\n", value);
+        return true;
+    }
+    if (strcmp(args, "flag on") == 0 || strcmp(args, "flag off") == 0) {
+        picQualityFlagEnabled = strcmp(args, "flag on") == 0;
+        requestNvsWrite(NVS_HOLDOVER_CONFIG);
+        Serial.printf("dsPIC kalite bayragi: %s\n", picQualityFlagEnabled ? "ACIK" : "KAPALI");
+        return true;
+    }
+    return false;
+}
+
+bool cmdPicFormat(const char* args) {
+    if (strcmp(args, "v1") == 0 || strcmp(args, "v2") == 0) {
+        picFrameFormat = (args[1] == '2') ? PIC_FORMAT_V2 : PIC_FORMAT_V1;
+        requestNvsWrite(NVS_PIC_FRAME_CONFIG);
+    } else if (args[0] != '\0') {
+        return false;
+    }
+    Serial.printf("dsPIC kare bicimi: v%u (%s)\n", picFrameFormat,
+                  picFrameFormat == PIC_FORMAT_V2 ? "ikili, her saniye tam zaman + CRC-16" : "ASCII tarih/saat sirayla");
+    return true;
+}
+
+bool cmdPps(const char* args) {
+    if (strcmp(args, "on") == 0 || strcmp(args, "off") == 0) {
+        ppsEnabled = strcmp(args, "on") == 0;
+        requestNvsWrite(NVS_PIC_FRAME_CONFIG);
+    } else if (args[0] != '\0') {
+        return false;
+    }
+    Serial.printf("PPS (IO%d, %d us): %s\n", PPS_PIN, PPS_PULSE_WIDTH_US, ppsEnabled ? "ACIK" : "KAPALI");
+    return true;
+}
+
+bool cmdNtpServer(const char* args) {
+    if (strcmp(args, "on") == 0 || strcmp(args, "off") == 0) {
+        sntpServerEnabled = strcmp(args, "on") == 0;
+        requestNvsWrite(NVS_SNTP_SERVER_CONFIG);
+    } else if (args[0] != '\0') {
+        return false;
+    }
+    const SntpServerCounters& c = sntpServer.counters();
+    Serial.printf("SNTP sunucusu (UDP %d): %s\n", NTP_PORT, sntpServerEnabled ? "ACIK" : "KAPALI");
+    Serial.printf("Istek: %lu | Cevap: %lu | Senkron yok: %lu | Hiz siniri: %lu | Gecersiz: %lu | Gonderim hatasi: %lu\n",
+                  (unsigned long)c.requests, (unsigned long)c.replies, (unsigned long)c.refused,
+                  (unsigned long)c.rateLimited, (unsigned long)c.malformed, (unsigned long)c.sendFailed);
+    return true;
+}
+
+bool cmdMetrics(const char* args) {
+    if (telemetrySending) {
+        Serial.println("Telemetri tamponu HTTP cevabinda, biraz sonra tekrar deneyin");
+        return true;
+    }
+    size_t len = formatTelemetry(telemetryBuffer, sizeof(telemetryBuffer));
+    Serial.write((const uint8_t*)telemetryBuffer, len);
+    Serial.printf("-- %u bayt | HTTP %d%s: %s, %lu istek sunuldu --\n", (unsigned)len, TELEMETRY_HTTP_PORT,
+                  TELEMETRY_PATH, telemetryListening ? "DINLIYOR" : "AG BEKLENIYOR", (unsigned long)telemetryServed);
+    return true;
+}
+
+bool cmdForceSync(const char* args) {
+    Serial.println("Zorla NTP senkronizasyonu istendi, sonuc [NTP] satirinda.");
+    ntpRoundRequested = true;
+    return true;
+}
+
+bool cmdHelp(const char* args);
+
+const ConsoleCommand consoleCommands[] = {
+    { "status",     "",                         "Sistem durumu",                            cmdStatus },
+    { "reset",      "",                         "Guvenli restart",                          cmdReset },
+    { "wdt",        "",                         "Watchdog durumu",                          cmdWdt },
+    { "testmaster", "",                         "Master kart baglantisi test",              cmdTestMaster },
+    { "masterinfo", "",                         "Master kart bilgileri",                    cmdMasterInfo },
+    { "sync",       "",                         "Senkronizasyon durumu",                    cmdSync },
+    { "testsync",   "",                         "10 saniye senkronizasyon testi (arka planda)", cmdTestSync },
+    { "stop",       "",                         "Suren testi durdur",                       cmdStop },
+    { "forcesync",  "",                         "Zorla NTP senkronizasyonu",                cmdForceSync },
+    { "stats",      "[reset]",                  "Gonderim/NTP istatistikleri ('stats reset' sifirlar)", cmdStats },
+    { "profile",    "[reset]",                  "Gorev asama sureleri ve esik asimlari ('profile reset' sifirlar)", cmdProfile },
+    { "holdover",   "[max <us> | flag on|off]", "Holdover ayari ('holdover max <us>', 'holdover flag on|off')", cmdHoldover },
+    { "picformat",  "[v1|v2]",                  "dsPIC kare bicimi ('picformat v2' ikili + CRC-16)", cmdPicFormat },
+    { "pps",        "[on|off]",                 "Saniye basi darbe cikisi (IO32)",          cmdPps },
+    { "ntpserver",  "[on|off]",                 "Yerel aga SNTP sunucusu (UDP 123)",        cmdNtpServer },
+    { "metrics",    "",                         "Ag telemetrisi (HTTP GET /metrics ile ayni cikti)", cmdMetrics },
+    { "help",       "",                         "Bu yardim",                                cmdHelp },
+};
+#define CONSOLE_COMMAND_COUNT (sizeof(consoleCommands) / sizeof(consoleCommands[0]))
+
+bool cmdHelp(const char* args) {
+    Serial.println("\n=== KOMUTLAR ===");
+    for (size_t i = 0; i < CONSOLE_COMMAND_COUNT; i++) {
+        Serial.printf("%-10s - %s\n", consoleCommands[i].name, consoleCommands[i].help);
+    }
+    Serial.println("\n=== PROTOKOL ===");
+    Serial.println("Master kart: 192168u, 001002y, 192169w, 001001x");
+    Serial.println("dsPIC'e: Tarih/Saat gonderimi (v1) ya da STX..ETX ikili kare (v2)");
+    Serial.println("================\n");
+    return true;
+}
+
+// Konsol görevi hiçbir zaman beklemez: yalnızca tampondaki baytlar okunur,
+// satır tamamlanınca tablodan komut çalıştırılır
+void handleSerialCommands() {
+    while (Serial.available() > 0) {
+        if (!consoleReader.feed((char)Serial.read())) {
+            continue;
+        }
+        if (consoleReader.overflowed()) {
+            Serial.println("HATA: Komut cok uzun!");
+            continue;
+        }
+        dispatchConsoleLine(consoleReader.line());
+    }
+}
+
+void dispatchConsoleLine(const char* line) {
+    const char* args = "";
+    const ConsoleCommand* cmd = consoleFind(consoleCommands, CONSOLE_COMMAND_COUNT, line, &args);
+    if (cmd == NULL) {
+        Serial.printf("Bilinmeyen komut: %s ('help' ile liste)\n", line);
+        return;
+    }
+    // Argümansız komutlar fazladan kelime kabul etmez
+    bool valid = (cmd->usage[0] == '\0' && args[0] != '\0') ? false : cmd->handler(args);
+    if (!valid) {
+        Serial.printf("Kullanim: %s %s\n", cmd->name, cmd->usage);
+    }
+}
+
+void WiFiEvent(WiFiEvent_t event) {
+    switch (event) {
+        case ARDUINO_EVENT_ETH_START:
+            Serial.println("ETH Baslatildi");
+            ETH.setHostname("wt32-eth01-slave");
+            break;
+        case ARDUINO_EVENT_ETH_CONNECTED:
+            Serial.println("ETH Baglandi");
+            break;
+        case ARDUINO_EVENT_ETH_GOT_IP:
+            Serial.println("\n--- DHCP Bilgileri ---");
+            Serial.print("  IP Adresi: "); Serial.println(ETH.localIP());
+            Serial.print("  Ag Gecidi: "); Serial.println(ETH.gatewayIP());
+            Serial.print("  DNS: "); Serial.println(ETH.dnsIP());
+            Serial.println("----------------------");
+            ethConnected = true;
+            break;
+        case ARDUINO_EVENT_ETH_DISCONNECTED:
+            Serial.println("ETH Baglanti Kesildi");
+            ethConnected = false;
+            break;
+        case ARDUINO_EVENT_ETH_STOP:
+            Serial.println("ETH Durduruldu");
+            ethConnected = false;
+            break;
+        default:
+            break;
+    }
+}
+
+//================================================================================
+// KURULUM (SETUP)
+//================================================================================
+void setup() {
+    Serial.begin(115200);
+    logSetClock(&monotonicClock);
+    ntpConfigMutex = xSemaphoreCreateMutex();
+    
+    checkRebootReason();
+    initializeWatchdog();
+    
+    Serial.println("WT32-ETH01 NTP Slave Kart baslatiliyor...");
+    Serial.println("NTP bilgisi Master karttan alinacak");
+
+    esp_err_t ret = nvs_flash_init();
+    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        Serial.println("NVS flash temizleniyor...");
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        ret = nvs_flash_init();
+    }
+    if (ret == ESP_OK) {
+        Serial.println("NVS flash baslatildi.");
+    }
+    loadHoldoverConfig();
+    loadPicFrameConfig();
+    loadSntpServerConfig();
+    loadWarmStart();
+
+    // Kayıtlı NTP sunucuları ağdan bağımsız; bağlantı gelir gelmez tur başlar
+    initializeNTPServers();
+    if (!ntpManager.hasValidConfig) {
+        Serial.println("!!! UYARI: Master karttan NTP konfigurasyonu bekleniyor !!!");
+    }
+    
+    feedWatchdog();
+
+    // Master kart ve dsPIC UART'ları (IDF sürücüsü, olay kuyruğu)
+    if (!setupUarts()) {
+        Serial.println("HATA: UART surucusu kurulamadi!");
+    }
+    if (!ppsOutput.begin((gpio_num_t)PPS_PIN)) {
+        Serial.println("HATA: PPS (RMT) cikisi kurulamadi!");
+    }
+    Serial.println("Master kart iletisimi baslatildi (IO36-RX / IO33-TX)");
+    Serial.printf("Baudrate: %d\n", MASTER_BAUD);
+    Serial.println("dsPIC iletisimi baslatildi (IO4-RX / IO14-TX)");
+    startUartRxTask();
+    setupPicSendTimer();
+
+    // Master el sıkışması arka planda; sonucu konsol görevi basar
+    startMasterTest();
+
+    // Ethernet bağlantısı beklenmez; GOT_IP sonrası ağ görevinde işlenir
+    WiFi.onEvent(WiFiEvent);
+    ETH.begin(ETH_ADDR, ETH_POWER_PIN, ETH_MDC_PIN, ETH_MDIO_PIN, ETH_TYPE, ETH_CLK_MODE);
+
+    // Sıcak başlangıç burada uygulanır; ilk tur bağlantı gelince başlar
+    setupPrecisionSync();
+    printWatchdogStatus();
+
+    Serial.println("\n=== SISTEM HAZIR (ag arka planda bekleniyor) ===");
+    Serial.println("Komutlar: 'status', 'reset', 'testmaster', 'masterinfo', 'help'");
+
+    startTasks();
+    bootTimeline.tasksStartedUs = esp_timer_get_time();
+}
+
+// Ağ görevinde: bağlantı ilk kez geldiğinde DNS ayarlanır ve ilk NTP turu
+// sorgu aralığı beklenmeden başlatılır
+void serviceBootSequence() {
+    static bool linkWarned = false;
+
+    if (bootTimeline.linkUpUs != 0) {
+        return;
+    }
+    if (!ethConnected) {
+        if (!linkWarned && millis() >= BOOT_LINK_WARN_MS) {
+            linkWarned = true;
+            LOGW(LOG_TAG_NET, "Ethernet %lu saniyedir yok, bekleniyor",
+                 (unsigned long)(BOOT_LINK_WARN_MS / 1000));
+        }
+        return;
+    }
+
+    bootTimeline.linkUpUs = esp_timer_get_time();
+    ETH.config(ETH.localIP(), ETH.gatewayIP(), ETH.subnetMask(),
+               IPAddress(8, 8, 8, 8), IPAddress(8, 8, 4, 4));
+    LOGI(LOG_TAG_NET, "Ethernet hazir: acilistan %lu ms", (unsigned long)(bootTimeline.linkUpUs / 1000));
+
+    if (ntpManager.hasValidConfig) {
+        updateTimeWithPrecision();
+    }
+}
+
+void printBootTimeline() {
+    const char* names[] = { "Gorevler", "Ethernet", "Ilk NTP", "Ilk dsPIC karesi" };
+    int64_t marks[] = { bootTimeline.tasksStartedUs, bootTimeline.linkUpUs,
+                        bootTimeline.firstSyncUs, bootTimeline.firstFrameUs };
+
+    Serial.println("\n=== ACILIS SURELERI (resetten) ===");
+    for (uint8_t i = 0; i < 4; i++) {
+        if (marks[i] != 0) {
+            Serial.printf("%-17s %lu ms\n", names[i], (unsigned long)(marks[i] / 1000));
+        } else {
+            Serial.printf("%-17s -\n", names[i]);
+        }
+    }
+    Serial.println("=================================\n");
+}
+
+//================================================================================
+// GÖREVLER
+//================================================================================
+
+void subscribeTaskWatchdog() {
+    if (wdtManager.isEnabled) {
+        esp_task_wdt_add(NULL);
+    }
+}
+
+void lockNtpConfig() {
+    if (ntpConfigMutex != NULL) {
+        xSemaphoreTake(ntpConfigMutex, portMAX_DELAY);
+    }
+}
+
+void unlockNtpConfig() {
+    if (ntpConfigMutex != NULL) {
+        xSemaphoreGive(ntpConfigMutex);
+    }
+}
+
+bool setupUarts() {
+    uartEventSet = xQueueCreateSet(UART_RX_EVENT_SET_LEN);
+    if (uartEventSet == NULL) {
+        return false;
+    }
+    bool ok = masterUart.begin(MASTER_BAUD, MASTER_RX_PIN, MASTER_TX_PIN,
+                               MASTER_RX_BUFFER, MASTER_TX_BUFFER, uartEventSet);
+    ok = picPort.begin(PIC_BAUD_RATE, PIC_RX_PIN, PIC_TX_PIN, PIC_RX_BUFFER, 0, uartEventSet) && ok;
+    return ok;
+}
+
+void startUartRxTask() {
+    if (uartEventSet == NULL || uartRxTaskHandle != NULL) {
+        return;
+    }
+    xTaskCreatePinnedToCore(uartRxTask, "uartRx", TASK_STACK_SIZE, NULL,
+                            UART_RX_TASK_PRIORITY, &uartRxTaskHandle, UART_RX_TASK_CORE);
+}
+
+void startTasks() {
+    xTaskCreatePinnedToCore(logDrainTask, "logDrain", TASK_STACK_SIZE, NULL,
+                            LOG_TASK_PRIORITY, &logTaskHandle, LOG_TASK_CORE);
+    // Çıkış görevi önce: zamanlayıcı onu uyandırabilmeli
+    xTaskCreatePinnedToCore(picOutputTask, "picOutput", TASK_STACK_SIZE, NULL,
+                            OUTPUT_TASK_PRIORITY, &picOutputTaskHandle, OUTPUT_TASK_CORE);
+    xTaskCreatePinnedToCore(netTask, "netNtp", TASK_STACK_SIZE, NULL,
+                            NET_TASK_PRIORITY, &netTaskHandle, NET_TASK_CORE);
+    xTaskCreatePinnedToCore(commsTask, "comms", TASK_STACK_SIZE, NULL,
+                            COMMS_TASK_PRIORITY, &commsTaskHandle, COMMS_TASK_CORE);
+    Serial.println("Gorevler baslatildi (cikis: cekirdek 1, ag/konsol: cekirdek 0)");
+}
+
+// Halkadaki log olaylarını metne çevirip basar. Seri port dolu olsa bile
+// yalnızca bu görev bekler; üreticiler etkilenmez.
+void logDrainTask(void* param) {
+    char line[160];
+    uint32_t reportedDrops = 0;
+
+    for (;;) {
+        LogEvent event;
+        while (logRing.pop(event)) {
+            logFormat(event, line, sizeof(line));
+            Serial.println(line);
+        }
+
+        uint32_t drops = logRing.dropped();
+        if (drops != reportedDrops) {
+            Serial.printf("[LOG] %lu olay dusuruldu (toplam %lu)\n",
+                          (unsigned long)(drops - reportedDrops), (unsigned long)drops);
+            reportedDrops = drops;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+void picOutputTask(void* param) {
+    subscribeTaskWatchdog();
+    for (;;) {
+        // Zamanlayıcı bildirimi yoksa da watchdog beslenebilsin
+        uint32_t events = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &events, pdMS_TO_TICKS(1000));
+        profileBegin(outputProfile);
+        if (events & PIC_NOTIFY_TIMER) {
+            handlePicTimerEvent();
+        }
+        if (events & PIC_NOTIFY_STATUS) {
+            writePendingPicStatus();
+        }
+        if (events & PIC_NOTIFY_ARM) {
+            startPicSendTimer();
+        }
+        profileMark(outputProfile, OUTPUT_STAGE_SEND);
+        serviceSendStatsReset();
+        feedWatchdog();
+        profileMark(outputProfile, OUTPUT_STAGE_STATS);
+        profileEnd(outputProfile);
+    }
+}
+
+void netTask(void* param) {
+    subscribeTaskWatchdog();
+    for (;;) {
+        profileBegin(netProfile);
+        serviceNetworkAndTime();
+        profileMark(netProfile, NET_STAGE_OUTPUT);
+        profileEnd(netProfile);
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+}
+
+// Yalnızca UART olayı geldiğinde uyanır. Master baytları ayrıştırıcıya
+// gider; dsPIC'ten gelen veri şimdilik yalnızca sayılır.
+void uartRxTask(void* param) {
+    subscribeTaskWatchdog();
+    uint8_t buf[64];
+    uint32_t reportedErrors = 0;
+
+    for (;;) {
+        // Olay yoksa da watchdog beslenebilsin
+        QueueSetMemberHandle_t member = xQueueSelectFromSet(uartEventSet, pdMS_TO_TICKS(1000));
+        profileBegin(uartRxProfile);
+        if (member == masterUart.eventQueue()) {
+            if (masterUart.serviceEvent()) {
+                size_t n;
+                while ((n = masterUart.read(buf, sizeof(buf))) > 0) {
+                    handleMasterBytes(buf, n);
+                }
+            }
+            profileMark(uartRxProfile, UART_STAGE_MASTER);
+        } else if (member == picPort.eventQueue()) {
+            if (picPort.serviceEvent()) {
+                while (picPort.read(buf, sizeof(buf)) > 0) {
+                }
+            }
+            profileMark(uartRxProfile, UART_STAGE_PIC);
+        }
+
+        const UartRxCounters& mc = masterUart.counters();
+        uint32_t errors = mc.fifoOverflows + mc.bufferFull + mc.framingErrors + mc.parityErrors;
+        if (errors != reportedErrors) {
+            LOGW(LOG_TAG_MASTER, "UART hatasi: tasma %lu, tampon %lu, cerceve %lu",
+                 (unsigned long)mc.fifoOverflows, (unsigned long)mc.bufferFull,
+                 (unsigned long)mc.framingErrors);
+            reportedErrors = errors;
+        }
+        feedWatchdog();
+        profileMark(uartRxProfile, UART_STAGE_COUNTERS);
+        profileEnd(uartRxProfile);
+    }
+}
+
+void commsTask(void* param) {
+    subscribeTaskWatchdog();
+    for (;;) {
+        profileBegin(commsProfile);
+        feedWatchdog();
+        handleSerialCommands();
+        profileMark(commsProfile, COMMS_STAGE_CONSOLE);
+        serviceMasterTest();
+        profileMark(commsProfile, COMMS_STAGE_MASTER_TEST);
+        serviceConsoleJob();
+        profileMark(commsProfile, COMMS_STAGE_JOB);
+        serviceTelemetry();
+        profileMark(commsProfile, COMMS_STAGE_TELEMETRY);
+        serviceNvsWrites();
+        profileMark(commsProfile, COMMS_STAGE_NVS);
+        profileEnd(commsProfile);
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+}
+
+//================================================================================
+// ANA DÖNGÜ (LOOP)
+//================================================================================
+void loop() {
+    // Tüm işler görevlerde yürür; Arduino loop görevi kendini kapatır
+    if (wdtManager.isEnabled) {
+        esp_task_wdt_delete(NULL);
+    }
+    vTaskDelete(NULL);
+}
+
+// Ağ/NTP görevinin bir turu; timeSync'in tek yazarı burasıdır
+void serviceNetworkAndTime() {
+    feedWatchdog();
+
+    if (precisionResyncRequested) {
+        precisionResyncRequested = false;
+        setupPrecisionSync();
+    }
+    serviceNtpStatsReset();
+    serviceHoldoverConfig();
+    serviceBootSequence();
+    profileMark(netProfile, NET_STAGE_CONFIG);
+    serviceSntpServer();
+    profileMark(netProfile, NET_STAGE_SNTP_SERVER);
+
+    static unsigned long lastNetworkCheck = 0;
+
+    // Ağ durumu kontrol
+    if (millis() - lastNetworkCheck >= 30000) {
+        lastNetworkCheck = millis();
+        
+        bool linkStatus = ETH.linkUp();
+        IPAddress currentIP = ETH.localIP();
+        
+        if (!linkStatus || currentIP.toString() == "0.0.0.0") {
+            if (ethConnected) {
+                LOGW(LOG_TAG_NET, "Ethernet baglantisi kesildi!");
+                ethConnected = false;
+            }
+        } else if (!ethConnected) {
+            LOGI(LOG_TAG_NET, "Ethernet yeniden kuruldu!");
+            ethConnected = true;
+        }
+        feedWatchdog();
+    }
+    // Bağlantı geri geldi (olay ya da yukarıdaki kontrol): uzun poll aralığı
+    // beklenmeden hemen bir tur atılır, holdover'dan çıkış gecikmez
+    static bool lastEthConnected = false;
+    if (ethConnected && !lastEthConnected && timeSync.isInitialized) {
+        LOGI(LOG_TAG_NET, "Ethernet geri geldi, NTP turu hemen baslatiliyor");
+        ntpRoundRequested = true;
+    }
+    lastEthConnected = ethConnected;
+    profileMark(netProfile, NET_STAGE_LINK);
+
+    // NTP senkronizasyonu - konsoldan zorla ya da uyarlanır aralıkla
+    // (iburst: 4 s, sonra 16..1024 s)
+    if (ntpRoundRequested) {
+        ntpRoundRequested = false;
+        updateTimeWithPrecision();
+    }
+    if (millis() - lastNtpRoundAt >= timeSync.poll.intervalMs()) {
+        if (ethConnected && ntpManager.hasValidConfig) {
+            updateTimeWithPrecision();
+        }
+    }
+    serviceNtpRound();
+    profileMark(netProfile, NET_STAGE_NTP);
+
+    // Ethernet yok: saat disiplinliyse son frekans tahminiyle holdover'a geçilir
+    int64_t nowUs = esp_timer_get_time();
+    if (!ethConnected && timeSync.isInitialized && timeSync.holdover.enter(nowUs)) {
+        LOGW(LOG_TAG_SYNC, "Holdover: Ethernet yok, hata siniri %lu us",
+             (unsigned long)timeSync.holdover.errorBoundUs(nowUs));
+        publishTimeSnapshot();
+    }
+
+    // Senkron yok ya da hata sınırı eşiği aştı: durum koduna dönülür
+    ClockQuality quality = timeSync.isInitialized ? timeSync.holdover.quality(nowUs) : CLOCK_UNLOCKED;
+    static ClockQuality lastQuality = CLOCK_UNLOCKED;
+    if (quality == CLOCK_UNLOCKED && lastQuality == CLOCK_HOLDOVER) {
+        LOGE(LOG_TAG_SYNC, "Holdover esigi asildi (%lu us), durum koduna donuluyor",
+             (unsigned long)timeSync.holdover.maxErrorUs());
+    }
+    lastQuality = quality;
+
+    if (quality == CLOCK_UNLOCKED || !ntpManager.hasValidConfig || getPreciseEpochTime() < 100000) {
+        setPicOutputEnabled(false);
+        static unsigned long lastStatusSend = 0;
+        if (millis() - lastStatusSend >= 1000) {
+            lastStatusSend = millis();
+            sendStatusToPic(ethConnected ? 'X' : 'Y');
+        }
+        return;
+    }
+
+    // SENKRON GÖNDERİM - zamanlayıcı kurulu değilse kur
+    setPicOutputEnabled(true);
 }
\ No newline at end of file
@@ -0,0 +1,483 @@
+//================================================================================
+// HOST ZAMANLAMA SIMULATORU (env:native)
+//================================================================================
+// Firmware'in zamanlama yolunu donanimsiz calistirir:
+//   sahte NTP sunuculari -> SntpEngine -> NtpSelect -> ClockDiscipline
+//   -> SendScheduler -> UART
+// Yerel saat bilinen bir frekans hatasiyla kayar, ag gecikmesi rastgeledir.
+// Sunuculardan biri sabit hatali zaman verir ve her turda ayiklanmalidir.
+// Bir sure tum sunucular susar; cikis holdover ile kesintisiz surmelidir.
+// Her saniyenin gonderim ani gercek UTC ile karsilastirilir; yakinsamadan
+// sonraki sapma SEND_TOLERANCE'i asarsa ya da saniye atlanirsa cikis kodu 1.
+// Modul birim testleri test/test_native altindadir (pio test -e native).
+//
+// Calistirma: pio run -e native -t exec
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "MockHal.h"
+#include "SntpEngine.h"
+#include "SntpServer.h"
+#include "NtpSelect.h"
+#include "ClockDiscipline.h"
+#include "PollController.h"
+#include "SendScheduler.h"
+#include "DsPicFrame.h"
+#include "CivilTime.h"
+#include "Holdover.h"
+#include "TimingStats.h"
+#include "TxCompensation.h"
+#include "Pps.h"
+
+// Firmware ile ayni degerler (src/main.cpp)
+#define TARGET_SEND_MS          50
+#define SEND_TOLERANCE          2
+#define NTP_SAMPLES_PER_ROUND   3
+#define NTP_SAMPLE_SPACING_MS   100
+#define PIC_TIMER_MIN_LEAD_US   500
+#define PIC_SPIN_GUARD_US       200
+#define NTP_UTC_OFFSET_S        10800
+#define PIC_BAUD_RATE           115200
+
+// Senaryo
+#define SIM_DURATION_S          3600
+#define SIM_SETTLE_S            300         // Bu sureden once sapma istatistige girmez
+#define SIM_DRIFT_PPB           25000       // Yerel kristal +25 ppm hizli
+#define SIM_TIMER_LATENCY_US    40          // esp_timer gorev gecikmesi
+#define SIM_UART_DRIVER_LATENCY_US 35       // write() -> ilk baslangic biti
+#define SIM_TICK_US             1000
+#define SIM_UTC_BASE_US         1792108800000000LL  // 2026-10-16 00:00:00 UTC
+
+#define SIM_SERVER_COUNT        3
+#define SIM_FALSETICKER         2           // Bu sunucu SIM_FALSETICKER_BIAS_US hatali
+#define SIM_FALSETICKER_BIAS_US 30000
+
+#define SIM_OUTAGE_START_S      1800        // Sunucular bu araliktan cevap vermez (holdover)
+#define SIM_OUTAGE_S            900
+
+#define SIM_LAN_CLIENTS         300         // Her biri saniyede bir SNTP istegi
+#define SIM_LAN_GREEDY_PERIOD_US 20000      // Tek bir istemci 50 istek/s (hiz siniri)
+#define SIM_SERVER_PACKETS_PER_PASS 8       // Firmware SNTP_SERVER_PACKETS_PER_PASS
+
+#define SIM_CLIENT_IP   makeIPv4(10, 0, 0, 100)
+#define SIM_CLIENT_PORT 4123
+
+ManualClock simClock;
+
+// Gercek UTC: yerel saat SIM_DRIFT_PPB kadar hizli calisir
+int64_t trueUtcUs(int64_t localUs) {
+    return SIM_UTC_BASE_US + localUs - (localUs * SIM_DRIFT_PPB) / 1000000000LL;
+}
+
+uint32_t simRandom() {
+    static uint32_t state = 0x12345678UL;
+    state = state * 1664525UL + 1013904223UL;
+    return state >> 8;
+}
+
+// Yerel ag: 0.2..1.2 ms arasi tek yon gecikme
+int64_t randomDelayUs() { return 200 + (int64_t)(simRandom() % 1000); }
+
+//================================================================================
+// SAHTE NTP SUNUCUSU
+//================================================================================
+// reachable false: istekler ag kesintisindeki gibi cevapsiz kaybolur
+void serviceSimServer(LoopbackUdp &server, int64_t biasUs, bool reachable) {
+    uint8_t pkt[NTP_PACKET_SIZE];
+    uint32_t fromIp;
+    uint16_t fromPort;
+    while (server.receive(pkt, sizeof(pkt), &fromIp, &fromPort) == NTP_PACKET_SIZE) {
+        if (!reachable) {
+            continue;
+        }
+        int64_t rx = trueUtcUs(simClock.nowUs()) + biasUs;
+
+        uint8_t reply[NTP_PACKET_SIZE];
+        memset(reply, 0, sizeof(reply));
+        reply[NTP_OFF_LI_VN_MODE] = (0 << 6) | (NTP_VERSION << 3) | NTP_MODE_SERVER;
+        reply[NTP_OFF_STRATUM] = 1;
+        memcpy(reply + NTP_OFF_ORIGINATE, pkt + NTP_OFF_TRANSMIT, 8);
+        ntpWriteTimestamp(reply + NTP_OFF_RECEIVE, rx);
+        ntpWriteTimestamp(reply + NTP_OFF_TRANSMIT, rx + 20);
+
+        server.setOneWayDelay(randomDelayUs());
+        server.send(fromIp, fromPort, reply, sizeof(reply));
+    }
+}
+
+// Yerel agdaki paneller, kartin SNTP sunucusunun soketi olarak. Istekler
+// zamani geldikce receive()'dan cikar, cevaplar send()'de dogrulanir.
+// Panel saati gercek UTC'dir ve ag gecikmesi yoktur; cevaptan hesaplanan
+// ofset dogrudan kartin saat hatasidir ve kok mesafesi icinde kalmalidir.
+class LanClients : public UdpTransport {
+public:
+    LanClients() : nextRegularUs_(0), nextGreedyUs_(0), regularIndex_(0), regularRequests(0),
+                   regularReplies(0), greedyRequests(0), greedyReplies(0), checked(0),
+                   outsideRootDistance(0), badHeader(0), maxAbsOffsetUs(0) {}
+
+    size_t receive(uint8_t *buf, size_t capacity, uint32_t *fromIp, uint16_t *fromPort) override {
+        int64_t now = simClock.nowUs();
+        if (capacity < NTP_PACKET_SIZE) {
+            return 0;
+        }
+        if (now >= nextGreedyUs_) {
+            nextGreedyUs_ += SIM_LAN_GREEDY_PERIOD_US;
+            greedyRequests++;
+            *fromIp = GREEDY_IP;
+        } else if (now >= nextRegularUs_) {
+            nextRegularUs_ += 1000000 / SIM_LAN_CLIENTS;
+            regularRequests++;
+            *fromIp = makeIPv4(10, 0, 1, 0) + (regularIndex_++ % SIM_LAN_CLIENTS);
+        } else {
+            return 0;
+        }
+        memset(buf, 0, NTP_PACKET_SIZE);
+        buf[NTP_OFF_LI_VN_MODE] = (NTP_VERSION << 3) | NTP_MODE_CLIENT;
+        ntpWriteTimestamp(buf + NTP_OFF_TRANSMIT, trueUtcUs(now));
+        *fromPort = NTP_PORT;
+        return NTP_PACKET_SIZE;
+    }
+
+    bool send(uint32_t ip, uint16_t port, const uint8_t *data, size_t len) override {
+        (void)port;
+        if (ip == GREEDY_IP) {
+            greedyReplies++;
+        } else {
+            regularReplies++;
+        }
+        if (len != NTP_PACKET_SIZE || data[NTP_OFF_LI_VN_MODE] != ((NTP_VERSION << 3) | NTP_MODE_SERVER) ||
+            data[NTP_OFF_STRATUM] != 2 || ntpReadU32(data + NTP_OFF_REF_ID) != makeIPv4(10, 0, 0, 1)) {
+            // Sistem sunucusu her zaman dogru sunuculardan biri: 10.0.0.1 ya da 10.0.0.2
+            if (ntpReadU32(data + NTP_OFF_REF_ID) != makeIPv4(10, 0, 0, 2) || data[NTP_OFF_STRATUM] != 2) {
+                badHeader++;
+            }
+        }
+        if (simClock.nowUs() < (int64_t)SIM_SETTLE_S * 1000000) {
+            return true;
+        }
+        int64_t t1 = ntpTimestampToUnixUs(data + NTP_OFF_ORIGINATE);
+        int64_t t2 = ntpTimestampToUnixUs(data + NTP_OFF_RECEIVE);
+        int64_t t3 = ntpTimestampToUnixUs(data + NTP_OFF_TRANSMIT);
+        int64_t t4 = trueUtcUs(simClock.nowUs());
+        int64_t offset = ((t2 - t1) + (t3 - t4)) / 2;
+        int64_t absOffset = offset < 0 ? -offset : offset;
+        // Kok mesafesi = kok gecikmesi / 2 + kok dagilimi (1 us kisa format payi)
+        uint32_t rootDistance = ntpShortToUs(data + NTP_OFF_ROOT_DELAY) / 2 +
+                                ntpShortToUs(data + NTP_OFF_ROOT_DISP) + 1;
+        if (absOffset > rootDistance) {
+            outsideRootDistance++;
+        }
+        if (absOffset > maxAbsOffsetUs) {
+            maxAbsOffsetUs = absOffset;
+        }
+        checked++;
+        return true;
+    }
+
+    static const uint32_t GREEDY_IP = 0x0A0002FE;   // 10.0.2.254
+
+private:
+    int64_t nextRegularUs_;
+    int64_t nextGreedyUs_;
+    uint32_t regularIndex_;
+
+public:
+    uint32_t regularRequests;
+    uint32_t regularReplies;
+    uint32_t greedyRequests;
+    uint32_t greedyReplies;
+    uint32_t checked;
+    uint32_t outsideRootDistance;
+    uint32_t badHeader;
+    int64_t maxAbsOffsetUs;
+};
+
+// Firmware'deki buildPicFrameFor ile ayni: takvim + bicim + checksum
+static void buildFrameForSecond(char *out, uint32_t second, bool isDate) {
+    static CivilClock civil(NTP_UTC_OFFSET_S);
+    civil.seek(second);
+    if (isDate) {
+        buildPicDateFrame(out, civil.day(), civil.month(), civil.yearOfCentury());
+    } else {
+        buildPicTimeFrame(out, civil.hour(), civil.minute(), civil.second());
+    }
+}
+
+//================================================================================
+// SIMULASYON
+//================================================================================
+int main() {
+    bool ok = true;
+
+    LoopbackUdp clientUdp(simClock, SIM_CLIENT_IP, SIM_CLIENT_PORT);
+    LoopbackUdp serverUdp[SIM_SERVER_COUNT] = {
+        LoopbackUdp(simClock, makeIPv4(10, 0, 0, 1), NTP_PORT),
+        LoopbackUdp(simClock, makeIPv4(10, 0, 0, 2), NTP_PORT),
+        LoopbackUdp(simClock, makeIPv4(10, 0, 0, 3), NTP_PORT)
+    };
+    uint32_t serverIps[SIM_SERVER_COUNT];
+    for (uint8_t i = 0; i < SIM_SERVER_COUNT; i++) {
+        serverUdp[i].connect(clientUdp);
+        serverIps[i] = makeIPv4(10, 0, 0, i + 1);
+    }
+
+    CaptureUart picUart(simClock, PIC_BAUD_RATE, SIM_UART_DRIVER_LATENCY_US);
+    UartTxCompensator txComp(PIC_BAUD_RATE);
+    uint32_t txLeadUs = 0;
+    CapturePulse ppsPins(simClock);
+    PpsGenerator pps(ppsPins);
+    int64_t ppsAtLocal = -1;        // Bekleyen PPS kenari (yerel)
+    SendStats ppsStats;
+    LanClients lan;
+    SntpServer lanServer(lan, simClock);
+    SntpReference reference;
+    memset(&reference, 0, sizeof(reference));
+    uint32_t repliesBeforeSync = 0;
+    double serverSeconds = 0;
+    uint32_t serverPackets = 0;
+    SntpEngine engine(clientUdp, simClock);
+    engine.setServers(serverIps, SIM_SERVER_COUNT);
+
+    ClockDiscipline discipline;
+    PollController poll;
+    discipline.setTimeConstant(poll.timeConstantS());
+    SendScheduler scheduler(TARGET_SEND_MS * 1000UL);
+
+    // Tur durumu (main.cpp NtpPollRound ile ayni mantik)
+    int64_t nextRoundAt = 0;
+    int64_t nextSampleAt = -1;
+    uint8_t samplesTaken = 0;
+    NtpPeerFilter filters[SIM_SERVER_COUNT];
+    uint32_t selectedRounds = 0;
+    uint32_t falsetickerRejected = 0;
+    uint32_t requests = 0;
+
+    int64_t fireAtLocal = -1;
+    bool nextIsTarih = true;
+    PicFrameCache frameCache;       // Firmware gibi: kare zamanlayici kurulurken hazirlanir
+    uint32_t cacheMisses = 0;
+    int64_t maxAbsDevUs = 0;
+    int64_t sumAbsDevUs = 0;
+    uint32_t measured = 0;
+    uint32_t outOfTolerance = 0;
+    SendStats sendStats;            // Firmware 'stats' komutuyla ayni histogram
+    HoldoverTracker holdover;
+    uint32_t holdoverEntries = 0;
+    uint32_t holdoverSends = 0;
+    uint32_t maxHoldoverBoundUs = 0;
+
+    int64_t endUs = (int64_t)SIM_DURATION_S * 1000000;
+    while (simClock.nowUs() < endUs) {
+        int64_t now = simClock.nowUs();
+
+        // PPS: firmware gibi kenardan PIC_SPIN_GUARD_US once uyanir, kalan
+        // sureyi bekler; kenar dogrulugu gercek UTC saniye basina gore
+        int64_t ppsWake = ppsAtLocal - PIC_SPIN_GUARD_US + SIM_TIMER_LATENCY_US;
+        if (ppsAtLocal >= 0 && ppsWake <= now + SIM_TICK_US) {
+            simClock.set(ppsWake > ppsAtLocal ? ppsWake : (ppsAtLocal > now ? ppsAtLocal : now));
+            ppsAtLocal = -1;
+            uint32_t second = scheduler.pendingSecond();
+            pps.fire(second);
+            if (simClock.nowUs() >= (int64_t)SIM_SETTLE_S * 1000000) {
+                ppsStats.recordPps(trueUtcUs(ppsPins.lastEdgeUs()) - PpsGenerator::edgeUtcUs(second));
+            }
+            continue;
+        }
+
+        // Zamanlayici bu adimda dolacaksa tam o ana git
+        if (fireAtLocal >= 0 && fireAtLocal + SIM_TIMER_LATENCY_US <= now + SIM_TICK_US) {
+            simClock.set(fireAtLocal + SIM_TIMER_LATENCY_US);
+            fireAtLocal = -1;
+
+            int64_t deviationUs = discipline.toUtcUs(simClock.nowUs()) + txLeadUs - scheduler.pendingTargetUtcUs();
+            if (deviationUs > (int64_t)SEND_TOLERANCE * 1000) {
+                scheduler.markSkipped();
+            } else if (deviationUs >= -(int64_t)SEND_TOLERANCE * 1000) {
+                PicFrameKind kind = nextIsTarih ? PIC_FRAME_DATE : PIC_FRAME_TIME;
+                const char *frame = frameCache.frameFor(scheduler.pendingSecond(), kind);
+                if (frame == NULL) {
+                    cacheMisses++;
+                    buildFrameForSecond(frameCache.beginPrepare(), scheduler.pendingSecond(), nextIsTarih);
+                    frameCache.publish(scheduler.pendingSecond(), kind, PIC_FRAME_LEN, 0);
+                    frame = frameCache.frameFor(scheduler.pendingSecond(), kind);
+                }
+                picUart.write((const uint8_t *)frame, frameCache.length());
+                const CaptureUart::Write &w = picUart.last();
+                txComp.record(w.len, (uint32_t)(w.doneUs - w.atUs));
+                scheduler.markSent();
+                if (holdover.inHoldover()) {
+                    holdoverSends++;
+                    uint32_t bound = holdover.errorBoundUs(simClock.nowUs());
+                    if (bound > maxHoldoverBoundUs) maxHoldoverBoundUs = bound;
+                }
+                nextIsTarih = !nextIsTarih;
+
+                // Dogruluk son durma bitinin indigi anda olculur
+                int64_t trueDev = trueUtcUs(w.doneUs) - scheduler.pendingTargetUtcUs();
+                if (simClock.nowUs() >= (int64_t)SIM_SETTLE_S * 1000000) {
+                    int64_t a = trueDev < 0 ? -trueDev : trueDev;
+                    if (a > maxAbsDevUs) maxAbsDevUs = a;
+                    if (a > (int64_t)SEND_TOLERANCE * 1000) outOfTolerance++;
+                    sumAbsDevUs += a;
+                    measured++;
+                    sendStats.recordSend(trueDev);
+                }
+            }
+            continue;
+        }
+
+        bool outage = now >= (int64_t)SIM_OUTAGE_START_S * 1000000 &&
+                      now < (int64_t)(SIM_OUTAGE_START_S + SIM_OUTAGE_S) * 1000000;
+        for (uint8_t i = 0; i < SIM_SERVER_COUNT; i++) {
+            serviceSimServer(serverUdp[i], i == SIM_FALSETICKER ? SIM_FALSETICKER_BIAS_US : 0, !outage);
+        }
+
+        // NTP turu
+        if (now >= nextRoundAt && nextSampleAt < 0 && !engine.busy()) {
+            nextRoundAt = now + (int64_t)poll.intervalMs() * 1000;
+            nextSampleAt = now;
+            samplesTaken = 0;
+            for (uint8_t i = 0; i < SIM_SERVER_COUNT; i++) filters[i].reset();
+        }
+        if (nextSampleAt >= 0 && !engine.busy() && now >= nextSampleAt) {
+            clientUdp.setOneWayDelay(randomDelayUs());
+            engine.startRequest();
+            samplesTaken++;
+            requests += SIM_SERVER_COUNT;
+        }
+        if (engine.busy()) {
+            SntpStatus st = engine.poll();
+            if (st != SNTP_PENDING) {
+                for (uint8_t i = 0; i < SIM_SERVER_COUNT; i++) {
+                    if (engine.serverStatus(i) == SNTP_COMPLETE) filters[i].add(engine.sample(i));
+                }
+                if (samplesTaken >= NTP_SAMPLES_PER_ROUND) {
+                    nextSampleAt = -1;
+                    NtpCandidate cands[SIM_SERVER_COUNT];
+                    uint8_t n = 0;
+                    for (uint8_t i = 0; i < SIM_SERVER_COUNT; i++) {
+                        if (filters[i].hasSample()) {
+                            ntpMakeCandidate(i, filters[i].best(), filters[i].jitterUs(), cands[n++]);
+                        }
+                    }
+                    NtpSelection sel;
+                    if (n > 0 && ntpSelectAndCombine(cands, n, sel)) {
+                        DisciplineAction action = discipline.update(sel.localUs, sel.localUs + sel.offsetUs);
+                        poll.update(action, discipline.state(), discipline.lastOffsetUs(), discipline.jitterUs());
+                        discipline.setTimeConstant(poll.timeConstantS());
+                        selectedRounds++;
+                        int64_t off = discipline.lastOffsetUs() < 0 ? -discipline.lastOffsetUs()
+                                                                    : discipline.lastOffsetUs();
+                        // Firmware syncErrorUs ile ayni: faz + jitter + yarim gecikme
+                        const SntpSample &system = filters[sel.systemPeer].best();
+                        holdover.synced(simClock.nowUs(), (uint32_t)off + discipline.jitterUs() +
+                                                          (uint32_t)system.delayUs / 2);
+                        reference.refId = serverIps[sel.systemPeer];
+                        reference.stratum = system.stratum;
+                        reference.rootDelayUs = system.rootDelayUs + (uint32_t)system.delayUs;
+                        reference.rootDispersionUs = system.rootDispersionUs;
+                        for (uint8_t i = 0; i < n; i++) {
+                            if (cands[i].server == SIM_FALSETICKER && !cands[i].truechimer) falsetickerRejected++;
+                        }
+                    } else {
+                        poll.roundFailed();
+                        if (discipline.isValid() && holdover.enter(simClock.nowUs())) holdoverEntries++;
+                    }
+                } else {
+                    nextSampleAt = simClock.nowUs() + (int64_t)NTP_SAMPLE_SPACING_MS * 1000;
+                }
+            }
+        }
+
+        // Yerel ag SNTP sunucusu: firmware ag gorevi gibi her turda sinirli paket
+        clock_t serveStart = clock();
+        serverPackets += lanServer.service(discipline, holdover, reference, SIM_SERVER_PACKETS_PER_PASS);
+        serverSeconds += (double)(clock() - serveStart) / CLOCKS_PER_SEC;
+        if (reference.stratum == 0) {
+            repliesBeforeSync = lan.regularReplies + lan.greedyReplies;
+        }
+
+        // Zamanlayiciyi bir sonraki saniyeye kur
+        if (discipline.isValid() && holdover.quality(now) != CLOCK_UNLOCKED && fireAtLocal < 0) {
+            PicFrameKind kind = nextIsTarih ? PIC_FRAME_DATE : PIC_FRAME_TIME;
+            txLeadUs = txComp.leadUs(picFrameLength(kind));
+            int64_t target = scheduler.planNext(discipline.toUtcUs(now), PIC_TIMER_MIN_LEAD_US + txLeadUs);
+            fireAtLocal = discipline.toLocalUs(target) - txLeadUs;
+            if (pps.due(scheduler.pendingSecond(), discipline.toUtcUs(now), PIC_TIMER_MIN_LEAD_US)) {
+                ppsAtLocal = discipline.toLocalUs(PpsGenerator::edgeUtcUs(scheduler.pendingSecond()));
+            }
+            if (frameCache.frameFor(scheduler.pendingSecond(), kind) == NULL) {
+                buildFrameForSecond(frameCache.beginPrepare(), scheduler.pendingSecond(), nextIsTarih);
+                frameCache.publish(scheduler.pendingSecond(), kind, PIC_FRAME_LEN, 0);
+            }
+        }
+
+        simClock.advance(SIM_TICK_US);
+    }
+
+    printf("Sure: %d s | Kayma: %ld ppb | Tahmin: %ld ppb | Jitter: %lu us\n",
+           SIM_DURATION_S, (long)SIM_DRIFT_PPB, (long)discipline.frequencyPpb(),
+           (unsigned long)discipline.jitterUs());
+    printf("Gonderilen: %lu | Atlanan: %lu | Tekrar: %lu | UART yazim: %lu | Onbellek iskalama: %lu\n",
+           (unsigned long)scheduler.sentCount(), (unsigned long)scheduler.missedSeconds(),
+           (unsigned long)scheduler.duplicateSeconds(), (unsigned long)picUart.count(),
+           (unsigned long)cacheMisses);
+    printf("Sapma (+%dms hedefe, %d s sonrasi): ort %ld us | maks %ld us | tolerans disi %lu\n",
+           TARGET_SEND_MS, SIM_SETTLE_S,
+           measured ? (long)(sumAbsDevUs / measured) : 0L, (long)maxAbsDevUs,
+           (unsigned long)outOfTolerance);
+    printf("Sapma dagilimi: min %ld us | maks %ld us | p50<=%ld us | p99<=%ld us\n",
+           (long)sendStats.offsetUs.minValue(), (long)sendStats.offsetUs.maxValue(),
+           (long)sendStats.offsetUs.percentileBound(50), (long)sendStats.offsetUs.percentileBound(99));
+
+    printf("TX telafisi: %lu us erken (seri %lu + surucu %lu, gercek %d) | v2 karesi %lu us\n",
+           (unsigned long)txLeadUs, (unsigned long)txComp.serializationUs(PIC_FRAME_LEN),
+           (unsigned long)txComp.overheadUs(), SIM_UART_DRIVER_LATENCY_US,
+           (unsigned long)txComp.leadUs(PIC_V2_FRAME_LEN));
+
+    int64_t ppsMax = ppsStats.ppsOffsetUs.maxValue();
+    int64_t ppsMin = ppsStats.ppsOffsetUs.minValue();
+    int64_t ppsMaxAbs = ppsMax > -ppsMin ? ppsMax : -ppsMin;
+    printf("PPS: %lu darbe | kenar sapmasi min %ld us | maks %ld us | p99<=%ld us\n",
+           (unsigned long)ppsPins.count(), (long)ppsMin, (long)ppsMax,
+           (long)ppsStats.ppsOffsetUs.percentileBound(99));
+
+    const SntpServerCounters &sc = lanServer.counters();
+    printf("SNTP sunucusu: %lu istek (%d panel x 1/s + 1 x 50/s) | cevap %lu | senkron yok %lu | hiz siniri %lu | %.0f ns/istek\n",
+           (unsigned long)sc.requests, SIM_LAN_CLIENTS, (unsigned long)sc.replies,
+           (unsigned long)sc.refused, (unsigned long)sc.rateLimited,
+           serverPackets ? serverSeconds * 1e9 / serverPackets : 0.0);
+    printf("SNTP panel hatasi: maks %ld us | kok mesafesi disi %lu / %lu | asiri istemci %lu / %lu cevap\n",
+           (long)lan.maxAbsOffsetUs, (unsigned long)lan.outsideRootDistance, (unsigned long)lan.checked,
+           (unsigned long)lan.greedyReplies, (unsigned long)lan.greedyRequests);
+
+    printf("Secim turu: %lu | Ayiklanan yanlis sunucu: %lu\n",
+           (unsigned long)selectedRounds, (unsigned long)falsetickerRejected);
+    printf("NTP istegi: %lu | Son sorgu araligi: %lu s\n",
+           (unsigned long)requests, (unsigned long)poll.intervalS());
+    printf("Holdover: %lu kez | %lu kare | maks hata siniri %lu us\n",
+           (unsigned long)holdoverEntries, (unsigned long)holdoverSends,
+           (unsigned long)maxHoldoverBoundUs);
+
+    ok &= measured > 0 && outOfTolerance == 0;
+    ok &= selectedRounds > 0 && falsetickerRejected == selectedRounds;
+    ok &= poll.intervalS() > (1UL << POLL_MIN_EXP);
+    ok &= scheduler.missedSeconds() == 0 && scheduler.duplicateSeconds() == 0;
+    ok &= cacheMisses == 0;
+    // Sunucu yuku dsPIC cizelgesini bozmaz (atlanan/tekrar kontrolu asagida);
+    // senkron oncesi cevap yok, paneller kok mesafesi icinde, asiri istemci kisildi
+    ok &= sc.refused > 0 && repliesBeforeSync == 0 && lan.badHeader == 0;
+    ok &= lan.checked > 0 && lan.outsideRootDistance == 0;
+    ok &= lan.regularReplies + sc.refused >= lan.regularRequests * 99 / 100;
+    ok &= lan.greedyReplies * 5 < lan.greedyRequests;
+    // Kenar UART/dongu gecikmesi tasimaz; kare sapmasindan siki olmali
+    ok &= ppsPins.count() + 2 >= scheduler.sentCount() && ppsStats.ppsPulses > 0 && ppsMaxAbs <= maxAbsDevUs;
+    ok &= txComp.overheadUs() + 2 >= SIM_UART_DRIVER_LATENCY_US && txComp.overheadUs() <= SIM_UART_DRIVER_LATENCY_US + 2;
+    ok &= holdoverEntries > 0 && holdoverSends > 0 && holdover.quality(simClock.nowUs()) == CLOCK_LOCKED;
+
+    printf("%s\n", ok ? "SONUC: OK" : "SONUC: HATA");
+    return ok ? 0 : 1;
+}
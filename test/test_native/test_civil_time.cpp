@@ -0,0 +1,64 @@
+#include <unity.h>
+#include <time.h>
+
+#include "CivilTime.h"
+#include "test_suites.h"
+
+#define TEST_UTC_OFFSET_S   10800           // Firmware NTP_UTC_OFFSET_S
+#define TEST_BASE_SECOND    1792108800UL    // 2026-10-16 00:00:00 UTC
+
+static uint32_t testRandom() {
+    static uint32_t state = 0x12345678UL;
+    state = state * 1664525UL + 1013904223UL;
+    return state >> 8;
+}
+
+// Artimli takvim gmtime ile ayni sonucu vermeli
+static void assertMatchesGmtime(const CivilClock &civil, uint32_t second) {
+    time_t local = (time_t)second + TEST_UTC_OFFSET_S;
+    struct tm t;
+    gmtime_r(&local, &t);
+    TEST_ASSERT_EQUAL_UINT(t.tm_year + 1900, civil.year());
+    TEST_ASSERT_EQUAL_UINT(t.tm_mon + 1, civil.month());
+    TEST_ASSERT_EQUAL_UINT(t.tm_mday, civil.day());
+    TEST_ASSERT_EQUAL_UINT(t.tm_hour, civil.hour());
+    TEST_ASSERT_EQUAL_UINT(t.tm_min, civil.minute());
+    TEST_ASSERT_EQUAL_UINT(t.tm_sec, civil.second());
+}
+
+// 2024 artik gunu ve yil sonu dahil ardisik saniyeler
+static void test_consecutive_seconds() {
+    const uint32_t starts[] = { TEST_BASE_SECOND - 3 * 86400, 1709164800UL - 43200, 1767225600UL - 43200 };
+    CivilClock civil(TEST_UTC_OFFSET_S);
+    for (uint8_t r = 0; r < sizeof(starts) / sizeof(starts[0]); r++) {
+        for (uint32_t s = starts[r]; s < starts[r] + 4 * 86400; s++) {
+            civil.seek(s);
+            assertMatchesGmtime(civil, s);
+        }
+    }
+}
+
+// Rastgele atlamalar (1970..2106): her biri tam hesap
+static void test_random_jumps() {
+    CivilClock civil(TEST_UTC_OFFSET_S);
+    for (uint32_t i = 0; i < 100000; i++) {
+        uint32_t s = (testRandom() << 8) ^ testRandom();
+        civil.seek(s);
+        assertMatchesGmtime(civil, s);
+    }
+}
+
+// Ardisik saniyeler tam hesap gerektirmez
+static void test_incremental_path() {
+    CivilClock civil(TEST_UTC_OFFSET_S);
+    for (uint32_t i = 0; i < 86400; i++) {
+        civil.seek(TEST_BASE_SECOND + i);
+    }
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(2, civil.fullRecomputes());
+}
+
+void runCivilTimeTests() {
+    RUN_TEST(test_consecutive_seconds);
+    RUN_TEST(test_random_jumps);
+    RUN_TEST(test_incremental_path);
+}
@@ -0,0 +1,74 @@
+#include <unity.h>
+#include <string.h>
+
+#include "Console.h"
+#include "test_suites.h"
+
+static int consoleHits;
+static char consoleLastArgs[CONSOLE_LINE_MAX + 1];
+
+static bool consoleRecord(const char *args) {
+    consoleHits++;
+    strcpy(consoleLastArgs, args);
+    return true;
+}
+
+static const ConsoleCommand table[] = {
+    { "stats",    "[reset]", "", consoleRecord },
+    { "holdover", "",        "", consoleRecord },
+};
+
+// Satir parca parca gelse de tamamlanana kadar komut calismamali; bosluk,
+// backspace ve CRLF ayiklanir
+static void test_lines_dispatch() {
+    ConsoleLineReader reader;
+    const char *input = "  stat\x08ts   reset \r\n\r\nholdover max 2000\n";
+    int lines = 0;
+    consoleHits = 0;
+
+    for (const char *c = input; *c != '\0'; c++) {
+        if (!reader.feed(*c)) {
+            continue;
+        }
+        lines++;
+        const char *args = "";
+        const ConsoleCommand *cmd = consoleFind(table, 2, reader.line(), &args);
+        TEST_ASSERT_FALSE(reader.overflowed());
+        TEST_ASSERT_NOT_NULL(cmd);
+        TEST_ASSERT_TRUE(cmd->handler(args));
+    }
+    TEST_ASSERT_EQUAL_INT(2, lines);
+    TEST_ASSERT_EQUAL_INT(2, consoleHits);
+    TEST_ASSERT_EQUAL_STRING("max 2000", consoleLastArgs);
+}
+
+static void test_partial_names_rejected() {
+    const char *args = "";
+    TEST_ASSERT_NULL(consoleFind(table, 2, "stat", &args));
+    TEST_ASSERT_NULL(consoleFind(table, 2, "statsx", &args));
+}
+
+// Uzun satir kesilip calistirilmaz, sonraki satir etkilenmez
+static void test_overflow_line_rejected() {
+    ConsoleLineReader reader;
+    bool completed = false;
+    for (int i = 0; i < CONSOLE_LINE_MAX + 10; i++) {
+        completed |= reader.feed('a');
+    }
+    TEST_ASSERT_FALSE(completed);
+    TEST_ASSERT_TRUE(reader.feed('\n'));
+    TEST_ASSERT_TRUE(reader.overflowed());
+
+    for (const char *c = "stats\n"; *c != '\0'; c++) {
+        if (reader.feed(*c)) {
+            TEST_ASSERT_FALSE(reader.overflowed());
+            TEST_ASSERT_EQUAL_STRING("stats", reader.line());
+        }
+    }
+}
+
+void runConsoleTests() {
+    RUN_TEST(test_lines_dispatch);
+    RUN_TEST(test_partial_names_rejected);
+    RUN_TEST(test_overflow_line_rejected);
+}
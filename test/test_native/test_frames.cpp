@@ -0,0 +1,94 @@
+#include <unity.h>
+#include <string.h>
+
+#include "DsPicFrame.h"
+#include "Holdover.h"
+#include "test_suites.h"
+
+static void test_v1_frames() {
+    char frame[PIC_FRAME_LEN + 1];
+
+    buildPicDateFrame(frame, 16, 10, 26);
+    TEST_ASSERT_EQUAL_STRING("161026G", frame);
+    buildPicTimeFrame(frame, 23, 59, 59);
+    TEST_ASSERT_EQUAL_STRING("235959d", frame);
+}
+
+static void test_crc16_check_value() {
+    const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, crc16Ccitt(check, sizeof(check)));
+}
+
+static void test_v2_round_trip() {
+    PicV2Fields in = { 200, 26, 10, 16, 23, 59, 59, 50, CLOCK_HOLDOVER, 5 };
+    uint8_t frame[PIC_V2_FRAME_LEN];
+    buildPicV2Frame(frame, in);
+
+    PicV2Fields out;
+    TEST_ASSERT_TRUE(parsePicV2Frame(frame, out));
+    TEST_ASSERT_EQUAL_UINT8(200, out.sequence);
+    TEST_ASSERT_EQUAL_UINT8(26, out.year);
+    TEST_ASSERT_EQUAL_UINT8(10, out.month);
+    TEST_ASSERT_EQUAL_UINT8(16, out.day);
+    TEST_ASSERT_EQUAL_UINT8(23, out.hour);
+    TEST_ASSERT_EQUAL_UINT8(59, out.minute);
+    TEST_ASSERT_EQUAL_UINT8(59, out.second);
+    TEST_ASSERT_EQUAL_UINT(50, out.msPhase);
+    TEST_ASSERT_EQUAL_INT(CLOCK_HOLDOVER, out.quality);
+    TEST_ASSERT_EQUAL_UINT8(5, out.errorMs);
+}
+
+// CRC tek bit hatalarini ve komsu bayt takaslarini yakalamali; v1'in mod-10
+// toplami takaslari goremez (karsilastirma icin sayilir, dogrulanmaz)
+static void test_v2_crc_detects_corruption() {
+    PicV2Fields in = { 7, 26, 10, 16, 12, 34, 56, 50, CLOCK_LOCKED, 0 };
+    uint8_t frame[PIC_V2_FRAME_LEN];
+    buildPicV2Frame(frame, in);
+    PicV2Fields out;
+
+    for (uint8_t i = 1; i < 12; i++) {
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            frame[i] ^= (uint8_t)(1 << bit);
+            TEST_ASSERT_FALSE(parsePicV2Frame(frame, out));
+            frame[i] ^= (uint8_t)(1 << bit);
+        }
+    }
+
+    for (uint8_t i = 3; i < 11; i++) {
+        if (frame[i] == frame[i + 1]) {
+            continue;
+        }
+        uint8_t t = frame[i]; frame[i] = frame[i + 1]; frame[i + 1] = t;
+        TEST_ASSERT_FALSE(parsePicV2Frame(frame, out));
+        t = frame[i]; frame[i] = frame[i + 1]; frame[i + 1] = t;
+    }
+    TEST_ASSERT_TRUE(parsePicV2Frame(frame, out));
+}
+
+static void test_frame_cache_slots() {
+    PicFrameCache cache;
+    TEST_ASSERT_NULL(cache.frameFor(100, PIC_FRAME_DATE));
+
+    buildPicDateFrame(cache.beginPrepare(), 16, 10, 26);
+    cache.publish(100, PIC_FRAME_DATE, PIC_FRAME_LEN, 0);
+    // Arka yuva yazilirken on yuva bozulmamali
+    buildPicTimeFrame(cache.beginPrepare(), 23, 59, 59);
+    TEST_ASSERT_NOT_NULL(cache.frameFor(100, PIC_FRAME_DATE));
+    TEST_ASSERT_EQUAL_STRING("161026G", cache.frameFor(100, PIC_FRAME_DATE));
+
+    cache.publish(101, PIC_FRAME_TIME, PIC_FRAME_LEN, 0);
+    TEST_ASSERT_NULL(cache.frameFor(100, PIC_FRAME_DATE));
+    TEST_ASSERT_NULL(cache.frameFor(101, PIC_FRAME_DATE));
+    TEST_ASSERT_NULL(cache.frameFor(101, PIC_FRAME_V2));
+    TEST_ASSERT_EQUAL_UINT8(PIC_FRAME_LEN, cache.length());
+    TEST_ASSERT_NOT_NULL(cache.frameFor(101, PIC_FRAME_TIME));
+    TEST_ASSERT_EQUAL_STRING("235959d", cache.frameFor(101, PIC_FRAME_TIME));
+}
+
+void runFrameTests() {
+    RUN_TEST(test_v1_frames);
+    RUN_TEST(test_crc16_check_value);
+    RUN_TEST(test_v2_round_trip);
+    RUN_TEST(test_v2_crc_detects_corruption);
+    RUN_TEST(test_frame_cache_slots);
+}
@@ -0,0 +1,37 @@
+#include <unity.h>
+
+#include "Holdover.h"
+#include "test_suites.h"
+
+// Hata siniri PHI gibi buyur, esik asilinca saat guvenilmez olur
+static void test_quality_transitions() {
+    HoldoverTracker tracker;
+    tracker.setMaxErrorUs(2000);
+    TEST_ASSERT_EQUAL_INT(CLOCK_UNLOCKED, tracker.quality(0));
+
+    tracker.synced(1000000, 500);
+    TEST_ASSERT_EQUAL_INT(CLOCK_LOCKED, tracker.quality(2000000));
+    TEST_ASSERT_TRUE(tracker.enter(3000000));
+    TEST_ASSERT_FALSE(tracker.enter(4000000));
+    TEST_ASSERT_EQUAL_INT(CLOCK_HOLDOVER, tracker.quality(4000000));
+
+    tracker.synced(1600000000LL, 500);
+    TEST_ASSERT_EQUAL_INT(CLOCK_LOCKED, tracker.quality(1600000000LL));
+}
+
+// 1 ppm: 1500 us pay 1500 s'de biter
+static void test_error_bound_growth() {
+    HoldoverTracker tracker;
+    tracker.setMaxErrorUs(2000);
+    tracker.synced(1000000, 500);
+    tracker.enter(3000000);
+
+    TEST_ASSERT_EQUAL_UINT32(1500, tracker.errorBoundUs(1000000 + 1000000000LL));
+    TEST_ASSERT_EQUAL_INT(CLOCK_HOLDOVER, tracker.quality(1000000 + 1499000000LL));
+    TEST_ASSERT_EQUAL_INT(CLOCK_UNLOCKED, tracker.quality(1000000 + 1501000000LL));
+}
+
+void runHoldoverTests() {
+    RUN_TEST(test_quality_transitions);
+    RUN_TEST(test_error_bound_growth);
+}
@@ -0,0 +1,73 @@
+#include <unity.h>
+#include <string.h>
+
+#include "LoopProfiler.h"
+#include "test_suites.h"
+
+static const char *const names[] = { "konsol", "ntp", "cikis" };
+
+// 100 tur: ntp asamasi 10. turda 5 ms surer, digerleri kisa
+static int64_t runPasses(LoopProfiler &profile, int64_t t) {
+    for (int pass = 0; pass < 100; pass++) {
+        profile.beginPass(t);
+        t += 20;
+        profile.mark(0, t);
+        t += (pass == 10) ? 5000 : 30;
+        profile.mark(1, t);
+        t += 10;
+        profile.mark(2, t);
+        t += 5;                         // Isaretlenmeyen kuyruk tura sayilir
+        TEST_ASSERT_EQUAL(pass == 10, profile.endPass(t));
+        t += 1000;
+    }
+    return t;
+}
+
+static void test_stage_statistics() {
+    LoopProfiler profile(names, 3, 2000);
+    runPasses(profile, 1000000);
+
+    TEST_ASSERT_EQUAL_UINT32(100, profile.stage(1).count());
+    TEST_ASSERT_EQUAL_INT32(5000, profile.stage(1).maxValue());
+    TEST_ASSERT_EQUAL_INT32(20, profile.stage(0).maxValue());
+    TEST_ASSERT_EQUAL_INT32(5035, profile.pass().maxValue());
+}
+
+static void test_stall_records_longest_stage() {
+    LoopProfiler profile(names, 3, 2000);
+    runPasses(profile, 1000000);
+
+    TEST_ASSERT_EQUAL_UINT32(1, profile.stallCount());
+    TEST_ASSERT_EQUAL_UINT8(1, profile.stallsHeld());
+    TEST_ASSERT_EQUAL_UINT8(1, profile.stall(0).stage);
+    TEST_ASSERT_EQUAL_UINT32(5000, profile.stall(0).stageUs);
+    TEST_ASSERT_EQUAL_UINT32(5035, profile.stall(0).passUs);
+}
+
+// Halka tasar: en yeni kayitlar tutulur, en yenisi basta
+static void test_stall_ring_wraps() {
+    LoopProfiler profile(names, 3, 2000);
+    int64_t t = runPasses(profile, 1000000);
+    for (int i = 0; i < PROFILE_STALL_RING_LEN + 3; i++) {
+        profile.beginPass(t);
+        t += 3000 + i;
+        profile.mark(2, t);
+        profile.endPass(t);
+    }
+    TEST_ASSERT_EQUAL_UINT32(PROFILE_STALL_RING_LEN + 4, profile.stallCount());
+    TEST_ASSERT_EQUAL_UINT8(PROFILE_STALL_RING_LEN, profile.stallsHeld());
+    TEST_ASSERT_EQUAL_UINT8(2, profile.stall(0).stage);
+    TEST_ASSERT_EQUAL_UINT32(3000 + PROFILE_STALL_RING_LEN + 2, profile.stall(0).passUs);
+    TEST_ASSERT_EQUAL_UINT32(3000 + 3, profile.stall(PROFILE_STALL_RING_LEN - 1).passUs);
+
+    profile.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, profile.stallCount());
+    TEST_ASSERT_EQUAL_UINT32(0, profile.pass().count());
+    TEST_ASSERT_EQUAL_STRING("ntp", profile.stageName(1));
+}
+
+void runLoopProfilerTests() {
+    RUN_TEST(test_stage_statistics);
+    RUN_TEST(test_stall_records_longest_stage);
+    RUN_TEST(test_stall_ring_wraps);
+}
@@ -0,0 +1,20 @@
+#include <unity.h>
+
+#include "test_suites.h"
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+    UNITY_BEGIN();
+    runFrameTests();
+    runCivilTimeTests();
+    runHoldoverTests();
+    runWarmStartTests();
+    runMasterParserTests();
+    runSelectionTests();
+    runConsoleTests();
+    runTelemetryTests();
+    runLoopProfilerTests();
+    return UNITY_END();
+}
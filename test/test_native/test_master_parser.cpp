@@ -0,0 +1,80 @@
+#include <unity.h>
+#include <time.h>
+
+#include "MasterCommandParser.h"
+#include "TimeHal.h"
+#include "test_suites.h"
+
+static void test_stream_assembles_servers() {
+    static const char stream[] = "192168u001002y\r\n192169w001001x";
+
+    MasterCommandParser parser;
+    MasterConfigAssembler assembler;
+    MasterCommand cmd;
+    uint8_t found = 0;
+    uint8_t addresses = 0;
+
+    for (const char *p = stream; *p; p++) {
+        if (!parser.feed(*p, cmd)) continue;
+        uint8_t server;
+        TEST_ASSERT_TRUE(cmd.valid);
+        if (assembler.apply(cmd, &server) == MASTER_CFG_ADDRESS) addresses++;
+        found++;
+    }
+    TEST_ASSERT_EQUAL_UINT8(4, found);
+    TEST_ASSERT_EQUAL_UINT8(2, addresses);
+    TEST_ASSERT_EQUAL_HEX32(makeIPv4(192, 168, 1, 2), assembler.server(0));
+    TEST_ASSERT_EQUAL_HEX32(makeIPv4(192, 169, 1, 1), assembler.server(1));
+}
+
+// Oktet 255'i asarsa, rakam eksik ya da fazlaysa komut gecersizdir
+static void test_invalid_commands() {
+    static const char *invalid[] = { "256001u", "19216u", "1921680y", "x" };
+    MasterCommandParser parser;
+    MasterCommand cmd;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        bool completed = false;
+        for (const char *p = invalid[i]; *p; p++) {
+            completed = parser.feed(*p, cmd);
+        }
+        TEST_ASSERT_TRUE(completed);
+        TEST_ASSERT_FALSE(cmd.valid);
+    }
+}
+
+// Host hizi UART hizinin (115200 baud ~ 11.5 kB/s) en az 100 kati olmali
+static void test_throughput() {
+    static const char stream[] = "192168u001002y\r\n192169w001001x\r\n";
+    const uint32_t rounds = 200000;
+
+    MasterCommandParser parser;
+    MasterConfigAssembler assembler;
+    MasterCommand cmd;
+    uint32_t configs = 0;
+    uint64_t bytes = 0;
+
+    clock_t start = clock();
+    for (uint32_t r = 0; r < rounds; r++) {
+        for (const char *p = stream; *p; p++) {
+            if (!parser.feed(*p, cmd)) continue;
+            uint8_t server;
+            if (assembler.apply(cmd, &server) == MASTER_CFG_ADDRESS && server == MASTER_NTP_SERVERS - 1) {
+                configs += assembler.server(0) == makeIPv4(192, 168, 1, 2);
+                assembler.clear();
+            }
+        }
+        bytes += sizeof(stream) - 1;
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double bytesPerSecond = seconds > 0 ? bytes / seconds : 1e12;
+
+    TEST_ASSERT_EQUAL_UINT32(rounds, configs);
+    TEST_ASSERT_TRUE(bytesPerSecond > 100.0 * 11520);
+}
+
+void runMasterParserTests() {
+    RUN_TEST(test_stream_assembles_servers);
+    RUN_TEST(test_invalid_commands);
+    RUN_TEST(test_throughput);
+}
@@ -0,0 +1,42 @@
+#include <unity.h>
+
+#include "NtpSelect.h"
+#include "test_suites.h"
+
+static void makeCandidates(NtpCandidate *cands) {
+    // Ucu birbirine 200 us yakin, biri 50 ms uzakta
+    static const int64_t offsets[] = { 1000000, 1000200, 999850, 1050000 };
+    for (uint8_t i = 0; i < 4; i++) {
+        cands[i].server = i;
+        cands[i].localUs = 1000;
+        cands[i].offsetUs = offsets[i];
+        cands[i].rootDistUs = 1000;
+        cands[i].jitterUs = 100;
+    }
+}
+
+static void test_falseticker_rejected() {
+    NtpCandidate cands[4];
+    makeCandidates(cands);
+
+    NtpSelection sel;
+    TEST_ASSERT_TRUE(ntpSelectAndCombine(cands, 4, sel));
+    TEST_ASSERT_EQUAL_UINT8(3, sel.truechimers);
+    TEST_ASSERT_FALSE(cands[3].truechimer);
+    TEST_ASSERT_FALSE(cands[3].survivor);
+    TEST_ASSERT_TRUE(sel.offsetUs > 999850 && sel.offsetUs < 1000200);
+}
+
+// Iki sunucu uzlasamazsa cogunluk yoktur
+static void test_no_majority() {
+    NtpCandidate cands[4];
+    makeCandidates(cands);
+
+    NtpSelection sel;
+    TEST_ASSERT_FALSE(ntpSelectAndCombine(&cands[2], 2, sel));
+}
+
+void runSelectionTests() {
+    RUN_TEST(test_falseticker_rejected);
+    RUN_TEST(test_no_majority);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+//================================================================================
+// HOST BIRIM TESTLERI (env:native, Unity)
+//================================================================================
+// Her modulun testleri kendi dosyasindadir ve run*Tests() ile RUN_TEST
+// cagrilarini toplar; test_main.cpp hepsini sirayla calistirir.
+// Calistirma: pio test -e native
+
+void runFrameTests();
+void runCivilTimeTests();
+void runHoldoverTests();
+void runWarmStartTests();
+void runMasterParserTests();
+void runSelectionTests();
+void runConsoleTests();
+void runTelemetryTests();
+void runLoopProfilerTests();
@@ -0,0 +1,82 @@
+#include <unity.h>
+#include <string.h>
+
+#include "Telemetry.h"
+#include "test_suites.h"
+
+static void test_exposition_format() {
+    static const int32_t edges[] = { 0, 100 };
+    Histogram hist(edges, HIST_EDGE_COUNT(edges));
+    hist.add(-5);
+    hist.add(50);
+    hist.add(150);
+
+    char buf[1024];
+    MetricsWriter out(buf, sizeof(buf));
+    out.gauge("timesync_offset_us", "Son faz hatasi", -1234567890123LL);
+    out.counter("timesync_frames_sent_total", "Gonderilen kare", 4000000000UL);
+    out.family("timesync_ntp_rtt_us", "histogram", "NTP gidis-donus");
+    out.histogram("timesync_ntp_rtt_us", "server=\"1\"", hist);
+    const char *expected =
+        "# HELP timesync_offset_us Son faz hatasi\n"
+        "# TYPE timesync_offset_us gauge\n"
+        "timesync_offset_us -1234567890123\n"
+        "# HELP timesync_frames_sent_total Gonderilen kare\n"
+        "# TYPE timesync_frames_sent_total counter\n"
+        "timesync_frames_sent_total 4000000000\n"
+        "# HELP timesync_ntp_rtt_us NTP gidis-donus\n"
+        "# TYPE timesync_ntp_rtt_us histogram\n"
+        "timesync_ntp_rtt_us_bucket{server=\"1\",le=\"-1\"} 1\n"
+        "timesync_ntp_rtt_us_bucket{server=\"1\",le=\"99\"} 2\n"
+        "timesync_ntp_rtt_us_bucket{server=\"1\",le=\"+Inf\"} 3\n"
+        "timesync_ntp_rtt_us_sum{server=\"1\"} 195\n"
+        "timesync_ntp_rtt_us_count{server=\"1\"} 3\n";
+    TEST_ASSERT_FALSE(out.overflowed());
+    TEST_ASSERT_EQUAL_STRING(expected, buf);
+    TEST_ASSERT_EQUAL_UINT32(strlen(expected), out.length());
+}
+
+// Tampon yetmezse yarim satir kalmaz
+static void test_overflow_keeps_whole_lines() {
+    char small[60];
+    MetricsWriter tight(small, sizeof(small));
+    tight.gauge("timesync_offset_us", "Son faz hatasi", 1);
+    tight.sample("timesync_x", NULL, 2);
+    TEST_ASSERT_TRUE(tight.overflowed());
+    TEST_ASSERT_EQUAL_STRING("# HELP timesync_offset_us Son faz hatasi\ntimesync_x 2\n", small);
+}
+
+static void feed(HttpRequestReader &request, const char *text, int *completions) {
+    for (const char *c = text; *c != '\0'; c++) {
+        if (request.feed(*c) && completions != NULL) {
+            (*completions)++;
+        }
+    }
+}
+
+static void test_http_request_matching() {
+    HttpRequestReader request;
+    int completions = 0;
+    feed(request, "GET /metrics?x=1 HTTP/1.1\r\nHost: 10.0.0.5\r\n"
+                  "User-Agent: Prometheus/2.45.0 xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx\r\n\r\n",
+         &completions);
+    TEST_ASSERT_EQUAL_INT(1, completions);
+    TEST_ASSERT_TRUE(request.isGet("/metrics"));
+    TEST_ASSERT_FALSE(request.isGet("/"));
+
+    request.reset();
+    feed(request, "GET /metricsx HTTP/1.0\n\n", NULL);
+    TEST_ASSERT_TRUE(request.complete());
+    TEST_ASSERT_FALSE(request.isGet("/metrics"));
+
+    request.reset();
+    feed(request, "POST /metrics HTTP/1.1\r\n\r\n", NULL);
+    TEST_ASSERT_TRUE(request.complete());
+    TEST_ASSERT_FALSE(request.isGet("/metrics"));
+}
+
+void runTelemetryTests() {
+    RUN_TEST(test_exposition_format);
+    RUN_TEST(test_overflow_keeps_whole_lines);
+    RUN_TEST(test_http_request_matching);
+}
@@ -0,0 +1,76 @@
+#include <unity.h>
+#include <string.h>
+
+#include "WarmStart.h"
+#include "ClockDiscipline.h"
+#include "PollController.h"
+#include "TimeHal.h"
+#include "test_suites.h"
+
+#define TEST_DRIFT_PPB      25000       // Yerel kristal +25 ppm hizli
+#define TEST_UTC_BASE_US    1792108800000000LL
+
+static int64_t trueUtcUs(int64_t localUs) {
+    return TEST_UTC_BASE_US + localUs - (localUs * TEST_DRIFT_PPB) / 1000000000LL;
+}
+
+static WarmStartState sealedState() {
+    WarmStartState state;
+    memset(&state, 0, sizeof(state));
+    state.freqPpb = -TEST_DRIFT_PPB;
+    state.pollExp = 9;
+    state.lastServer = makeIPv4(10, 0, 0, 1);
+    warmStartSeal(state);
+    return state;
+}
+
+static void test_crc_protects_record() {
+    WarmStartState state = sealedState();
+    TEST_ASSERT_TRUE(warmStartValid(state));
+
+    WarmStartState corrupt = state;
+    corrupt.freqPpb++;
+    TEST_ASSERT_FALSE(warmStartValid(corrupt));
+}
+
+// NVS yazimi seyrek: gecersiz kayit hemen, kucuk degisim hic, buyuk
+// degisim en erken WARM_NVS_MIN_INTERVAL_S sonra
+static void test_nvs_write_policy() {
+    WarmStartState state = sealedState();
+    WarmStartState corrupt = state;
+    corrupt.freqPpb++;
+
+    WarmStartState next = state;
+    next.freqPpb += WARM_NVS_FREQ_DELTA_PPB / 2;
+    warmStartSeal(next);
+    TEST_ASSERT_TRUE(warmStartNvsDue(corrupt, next, 0));
+    TEST_ASSERT_FALSE(warmStartNvsDue(state, next, WARM_NVS_MIN_INTERVAL_S));
+
+    next.freqPpb += WARM_NVS_FREQ_DELTA_PPB;
+    warmStartSeal(next);
+    TEST_ASSERT_FALSE(warmStartNvsDue(state, next, WARM_NVS_MIN_INTERVAL_S - 1));
+    TEST_ASSERT_TRUE(warmStartNvsDue(state, next, WARM_NVS_MIN_INTERVAL_S));
+}
+
+// Bilinen frekansla ilk olcumden 100 s sonra faz hatasi kucuk kalmali
+static void test_warm_start_phase_error() {
+    WarmStartState state = sealedState();
+    ClockDiscipline discipline;
+    PollController poll;
+    discipline.warmStart(state.freqPpb);
+    poll.warmStart(state.pollExp);
+
+    DisciplineAction action = discipline.update(0, trueUtcUs(0));
+    poll.update(action, discipline.state(), 0, 0);
+    TEST_ASSERT_EQUAL_INT(DISC_SYNC, discipline.state());
+    TEST_ASSERT_EQUAL_UINT8(state.pollExp, poll.pollExponent());
+
+    int64_t local = 100000000LL;
+    TEST_ASSERT_INT_WITHIN(10, 0, (int32_t)(trueUtcUs(local) - discipline.toUtcUs(local)));
+}
+
+void runWarmStartTests() {
+    RUN_TEST(test_crc_protects_record);
+    RUN_TEST(test_nvs_write_policy);
+    RUN_TEST(test_warm_start_phase_error);
+}